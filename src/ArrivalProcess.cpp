@@ -0,0 +1,130 @@
+/**
+ * @file ArrivalProcess.cpp
+ * @brief Implementation of the built-in arrival models.
+ */
+
+#include "ArrivalProcess.h"
+#include <algorithm>
+#include <cmath>
+
+ArrivalProcess::ArrivalProcess(unsigned int seed) : rng(seed) {
+}
+
+ArrivalProcess::~ArrivalProcess() {
+}
+
+int ArrivalProcess::nextArrival(int fromCycle, int endCycle, int& count) {
+    for (int cycle = fromCycle; cycle < endCycle; cycle++) {
+        count = sample(cycle);
+        if (count > 0) {
+            return cycle;
+        }
+    }
+    count = 0;
+    return -1;
+}
+
+int ArrivalProcess::sampleBlock(int fromCycle, int cycles, int* counts) {
+    int total = 0;
+    for (int i = 0; i < cycles; i++) {
+        counts[i] = sample(fromCycle + i);
+        total += counts[i];
+    }
+    return total;
+}
+
+std::unique_ptr<ArrivalProcess> ArrivalProcess::create(const std::string& name, const Config& config, unsigned int seed) {
+    if (name == "bernoulli") {
+        return std::unique_ptr<ArrivalProcess>(new BernoulliArrivals(config.getNewRequestProb(), seed));
+    } else if (name == "poisson") {
+        return std::unique_ptr<ArrivalProcess>(new PoissonArrivals(config.getArrivalRate(), seed));
+    } else if (name == "mmpp") {
+        return std::unique_ptr<ArrivalProcess>(new MmppArrivals(config.getArrivalRate(), config.getBurstRate(),
+                                                                config.getQuietLength(), config.getBurstLength(), seed));
+    } else if (name == "diurnal") {
+        return std::unique_ptr<ArrivalProcess>(new DiurnalArrivals(config.getArrivalRate(), config.getDiurnalAmplitude(),
+                                                                   config.getDiurnalPeriod(), seed));
+    }
+    return nullptr;
+}
+
+BernoulliArrivals::BernoulliArrivals(double probability, unsigned int seed)
+    : ArrivalProcess(seed), probability(probability), unit(0.0, 1.0),
+      gap(std::min(std::max(probability, 1e-9), 1.0)) {
+}
+
+int BernoulliArrivals::sample(int cycle) {
+    (void)cycle;
+    return unit(rng) < probability ? 1 : 0;
+}
+
+int BernoulliArrivals::nextArrival(int fromCycle, int endCycle, int& count) {
+    count = 0;
+    if (probability <= 0.0) {
+        return -1;
+    }
+    int skipped = 0;
+    if (probability < 1.0) {
+        skipped = gap(rng);
+    }
+    if (skipped >= endCycle - fromCycle) {
+        return -1;
+    }
+    count = 1;
+    return fromCycle + skipped;
+}
+
+std::string BernoulliArrivals::getName() const {
+    return "bernoulli";
+}
+
+PoissonArrivals::PoissonArrivals(double rate, unsigned int seed)
+    : ArrivalProcess(seed), dis(std::max(rate, 1e-9)) {
+}
+
+int PoissonArrivals::sample(int cycle) {
+    (void)cycle;
+    return dis(rng);
+}
+
+std::string PoissonArrivals::getName() const {
+    return "poisson";
+}
+
+MmppArrivals::MmppArrivals(double quietRate, double burstRate, int quietLength, int burstLength, unsigned int seed)
+    : ArrivalProcess(seed), quiet(std::max(quietRate, 1e-9)), burst(std::max(burstRate, 1e-9)),
+      enterBurst(1.0 / std::max(quietLength, 1)), leaveBurst(1.0 / std::max(burstLength, 1)),
+      bursting(false), unit(0.0, 1.0) {
+}
+
+int MmppArrivals::sample(int cycle) {
+    (void)cycle;
+    if (unit(rng) < (bursting ? leaveBurst : enterBurst)) {
+        bursting = !bursting;
+    }
+    return bursting ? burst(rng) : quiet(rng);
+}
+
+std::string MmppArrivals::getName() const {
+    return "mmpp";
+}
+
+DiurnalArrivals::DiurnalArrivals(double rate, double amplitude, int period, unsigned int seed)
+    : ArrivalProcess(seed), rate(rate), amplitude(std::min(std::max(amplitude, 0.0), 1.0)),
+      period(std::max(period, 1)) {
+}
+
+int DiurnalArrivals::sample(int cycle) {
+    const double twoPi = 6.283185307179586;
+    double mean = rate * (1.0 + amplitude * std::sin(twoPi * (cycle % period) / period));
+    if (mean <= 0.0) {
+        return 0;
+    }
+    // the mean changes every cycle, so a fresh distribution is built for each draw
+    std::poisson_distribution<int> dis(mean);
+    return dis(rng);
+}
+
+std::string DiurnalArrivals::getName() const {
+    return "diurnal";
+}
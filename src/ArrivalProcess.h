@@ -0,0 +1,155 @@
+/**
+ * @file ArrivalProcess.h
+ * @brief Declaration of the ArrivalProcess interface and the built-in arrival models.
+ */
+
+#ifndef ARRIVALPROCESS_H
+#define ARRIVALPROCESS_H
+
+#include <memory>
+#include <random>
+#include <string>
+#include "Config.h"
+
+/**
+ * @class ArrivalProcess
+ * @brief Decides how many requests arrive on each clock cycle.
+ *
+ * Cycles must be sampled in increasing order, each at most once; models with
+ * state (such as the on/off burst model) advance it one cycle at a time.
+ * Every model owns its random engine, seeded at construction.
+ */
+class ArrivalProcess {
+    protected:
+        std::mt19937 rng;   ///< Engine for the arrival draws
+
+        /**
+         * @brief Seeds the model's engine.
+         * @param seed Seed for the engine.
+         */
+        explicit ArrivalProcess(unsigned int seed);
+
+    public:
+        virtual ~ArrivalProcess();
+
+        /**
+         * @brief Returns the number of requests arriving on a cycle.
+         * @param cycle Clock cycle to sample; later than every cycle sampled before.
+         * @return Arrival count, possibly 0.
+         */
+        virtual int sample(int cycle) = 0;
+
+        /**
+         * @brief Finds the first cycle in [fromCycle, endCycle) with at least one arrival.
+         *
+         * Used by the event loop to jump over empty cycles. The default samples
+         * each cycle in turn; memoryless models may skip ahead directly.
+         *
+         * @param fromCycle First cycle to consider.
+         * @param endCycle One past the last cycle to consider.
+         * @param count Set to the number of arrivals on the returned cycle.
+         * @return Cycle of the next arrival, or -1 if none occurs before endCycle.
+         */
+        virtual int nextArrival(int fromCycle, int endCycle, int& count);
+
+        /**
+         * @brief Samples a block of consecutive cycles in one call.
+         * @param fromCycle First cycle of the block.
+         * @param cycles Number of cycles in the block.
+         * @param counts Output array receiving one arrival count per cycle.
+         * @return Total arrivals in the block.
+         */
+        int sampleBlock(int fromCycle, int cycles, int* counts);
+
+        /** @brief Returns the model name as written in config.txt. */
+        virtual std::string getName() const = 0;
+
+        /**
+         * @brief Creates an arrival model from the configuration.
+         *
+         * Known names: bernoulli, poisson, mmpp, diurnal.
+         *
+         * @param name Model name.
+         * @param config Configuration providing the model's parameters.
+         * @param seed Seed for the model's engine.
+         * @return The new model, or nullptr if the name is unknown.
+         */
+        static std::unique_ptr<ArrivalProcess> create(const std::string& name, const Config& config, unsigned int seed);
+};
+
+/**
+ * @class BernoulliArrivals
+ * @brief At most one arrival per cycle with probability newRequestProb.
+ *
+ * This is the original arrival model. Empty stretches are skipped with one
+ * geometric draw.
+ */
+class BernoulliArrivals : public ArrivalProcess {
+    private:
+        double probability;                       ///< Chance of an arrival on each cycle
+        std::uniform_real_distribution<> unit;    ///< Uniform [0, 1) draw for the per-cycle trial
+        std::geometric_distribution<int> gap;     ///< Empty cycles before the next arrival
+
+    public:
+        BernoulliArrivals(double probability, unsigned int seed);
+        int sample(int cycle) override;
+        int nextArrival(int fromCycle, int endCycle, int& count) override;
+        std::string getName() const override;
+};
+
+/**
+ * @class PoissonArrivals
+ * @brief Poisson-distributed arrivals per cycle with a constant mean of arrivalRate.
+ */
+class PoissonArrivals : public ArrivalProcess {
+    private:
+        std::poisson_distribution<int> dis;   ///< Per-cycle arrival count distribution
+
+    public:
+        PoissonArrivals(double rate, unsigned int seed);
+        int sample(int cycle) override;
+        std::string getName() const override;
+};
+
+/**
+ * @class MmppArrivals
+ * @brief Two-state Markov-modulated Poisson process (bursty on/off traffic).
+ *
+ * In the quiet state arrivals are Poisson with mean arrivalRate per cycle, in
+ * the burst state with mean burstRate. The state lengths are geometric with
+ * means quietLength and burstLength cycles.
+ */
+class MmppArrivals : public ArrivalProcess {
+    private:
+        std::poisson_distribution<int> quiet;   ///< Arrival counts in the quiet state
+        std::poisson_distribution<int> burst;   ///< Arrival counts in the burst state
+        double enterBurst;                      ///< Per-cycle chance of switching quiet -> burst
+        double leaveBurst;                      ///< Per-cycle chance of switching burst -> quiet
+        bool bursting;                          ///< Current state
+        std::uniform_real_distribution<> unit;  ///< Uniform [0, 1) draw for state switches
+
+    public:
+        MmppArrivals(double quietRate, double burstRate, int quietLength, int burstLength, unsigned int seed);
+        int sample(int cycle) override;
+        std::string getName() const override;
+};
+
+/**
+ * @class DiurnalArrivals
+ * @brief Poisson arrivals whose mean follows a sinusoidal daily cycle.
+ *
+ * The mean on cycle t is arrivalRate * (1 + diurnalAmplitude * sin(2 pi t / diurnalPeriod)).
+ */
+class DiurnalArrivals : public ArrivalProcess {
+    private:
+        double rate;        ///< Mean arrivals per cycle over a whole period
+        double amplitude;   ///< Relative swing of the mean, in [0, 1]
+        int period;         ///< Cycles per simulated day
+
+    public:
+        DiurnalArrivals(double rate, double amplitude, int period, unsigned int seed);
+        int sample(int cycle) override;
+        std::string getName() const override;
+};
+
+#endif
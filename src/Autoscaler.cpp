@@ -0,0 +1,105 @@
+/**
+ * @file Autoscaler.cpp
+ * @brief Implementation of the built-in autoscalers.
+ */
+
+#include "Autoscaler.h"
+#include <algorithm>
+#include <cmath>
+
+/// Fraction of targetUtilization the pool must stay under after a scale-down
+static const double scaleDownHeadroom = 0.85;
+
+Autoscaler::~Autoscaler() {
+}
+
+void Autoscaler::recordArrivals(int count) {
+    (void)count;
+}
+
+void Autoscaler::recordCompletion(int serviceTime) {
+    (void)serviceTime;
+}
+
+std::unique_ptr<Autoscaler> Autoscaler::create(const std::string& name, const Config& config) {
+    if (name == "threshold") {
+        return std::unique_ptr<Autoscaler>(new ThresholdAutoscaler(config));
+    } else if (name == "predictive") {
+        return std::unique_ptr<Autoscaler>(new PredictiveAutoscaler(config));
+    }
+    return nullptr;
+}
+
+ThresholdAutoscaler::ThresholdAutoscaler(const Config& config)
+    : minQueuePerServer(config.getMinQueuePerServer()), maxQueuePerServer(config.getMaxQueuePerServer()) {
+}
+
+ScaleDecision ThresholdAutoscaler::decide(int currTime, int queueSize, int serverCount) {
+    (void)currTime;
+    if (queueSize > maxQueuePerServer * serverCount) {
+        return ScaleDecision{1, 0, "Queue size exceeds max threshold, adding server"};
+    }
+    if (queueSize < minQueuePerServer * serverCount) {
+        return ScaleDecision{-1, 0, "Queue size below min threshold, removing server"};
+    }
+    return ScaleDecision{0, 0, nullptr};
+}
+
+std::string ThresholdAutoscaler::getName() const {
+    return "threshold";
+}
+
+PredictiveAutoscaler::PredictiveAutoscaler(const Config& config)
+    : alpha(std::min(std::max(config.getEwmaAlpha(), 0.0001), 1.0)),
+      targetUtilization(std::min(std::max(config.getTargetUtilization(), 0.01), 1.0)),
+      drainHorizon(std::max(config.getDrainHorizon(), 1)),
+      maxScaleStep(std::max(config.getMaxScaleStep(), 1)),
+      arrivalRate(0.0), serviceTime(0.0), pendingArrivals(0), lastUpdate(0) {
+}
+
+void PredictiveAutoscaler::recordArrivals(int count) {
+    pendingArrivals += count;
+}
+
+void PredictiveAutoscaler::recordCompletion(int serviceTime) {
+    if (this->serviceTime == 0.0) {
+        this->serviceTime = serviceTime;
+    } else {
+        this->serviceTime += alpha * (serviceTime - this->serviceTime);
+    }
+}
+
+ScaleDecision PredictiveAutoscaler::decide(int currTime, int queueSize, int serverCount) {
+    // the event loop skips cycles, so fold the elapsed span in as that many per-cycle samples
+    int elapsed = currTime - lastUpdate;
+    if (elapsed > 0) {
+        double keep = std::pow(1.0 - alpha, elapsed);
+        arrivalRate = keep * arrivalRate + (1.0 - keep) * pendingArrivals / elapsed;
+        pendingArrivals = 0;
+        lastUpdate = currTime;
+    }
+
+    if (serviceTime == 0.0) {
+        return ScaleDecision{0, 0, nullptr};
+    }
+
+    double busy = arrivalRate * serviceTime;
+    double backlog = queueSize * serviceTime / drainHorizon;
+    double demand = busy + backlog;
+
+    // scaling down keeps some headroom below the target, so noise in the estimate does not flap the pool
+    int target = std::max(static_cast<int>(std::ceil(demand / targetUtilization)), 1);
+    if (target < serverCount) {
+        target = std::min(std::max(static_cast<int>(std::ceil(demand / (targetUtilization * scaleDownHeadroom))), 1), serverCount);
+    }
+    int delta = std::min(std::max(target - serverCount, -maxScaleStep), maxScaleStep);
+    if (delta == 0) {
+        return ScaleDecision{0, 0, nullptr};
+    }
+
+    return ScaleDecision{delta, target, delta > 0 ? "Predicted demand needs more servers" : "Predicted demand needs fewer servers"};
+}
+
+std::string PredictiveAutoscaler::getName() const {
+    return "predictive";
+}
@@ -0,0 +1,129 @@
+/**
+ * @file Autoscaler.h
+ * @brief Declaration of the Autoscaler interface and the built-in scaling policies.
+ */
+
+#ifndef AUTOSCALER_H
+#define AUTOSCALER_H
+
+#include <memory>
+#include <string>
+#include "Config.h"
+
+/**
+ * @struct ScaleDecision
+ * @brief Outcome of one autoscaler evaluation.
+ */
+struct ScaleDecision {
+    int delta;            ///< Servers to add (positive) or remove (negative); 0 to hold
+    int target;           ///< Server count the autoscaler aims for, or 0 if it does not model one
+    const char* reason;   ///< Explanation written to the log when delta is non-zero; static text, so deciding never allocates
+};
+
+/**
+ * @class Autoscaler
+ * @brief Decides how many servers the pool should gain or lose.
+ *
+ * The LoadBalancer reports every accepted arrival and every completion, then
+ * asks for a decision whenever it checks scaling. The LoadBalancer still
+ * enforces the cooldown between scaling events and only removes idle servers.
+ */
+class Autoscaler {
+    public:
+        virtual ~Autoscaler();
+
+        /**
+         * @brief Records requests accepted into the queue.
+         * @param count Number of requests accepted.
+         */
+        virtual void recordArrivals(int count);
+
+        /**
+         * @brief Records one completed request.
+         * @param serviceTime Cycles the request spent on its server.
+         */
+        virtual void recordCompletion(int serviceTime);
+
+        /**
+         * @brief Evaluates the current load.
+         * @param currTime Current simulation clock cycle.
+         * @param queueSize Number of requests waiting to start.
+         * @param serverCount Number of servers in the pool.
+         * @return Requested change in server count and the reason for it.
+         */
+        virtual ScaleDecision decide(int currTime, int queueSize, int serverCount) = 0;
+
+        /** @brief Returns the autoscaler name as written in config.txt. */
+        virtual std::string getName() const = 0;
+
+        /**
+         * @brief Creates an autoscaler by name.
+         *
+         * Known names: threshold, predictive.
+         *
+         * @param name Autoscaler name.
+         * @param config Configuration providing the autoscaler's parameters.
+         * @return The new autoscaler, or nullptr if the name is unknown.
+         */
+        static std::unique_ptr<Autoscaler> create(const std::string& name, const Config& config);
+};
+
+/**
+ * @class ThresholdAutoscaler
+ * @brief Adds or removes one server when the queue leaves the per-server band.
+ *
+ * Scales up when the queue exceeds maxQueuePerServer * servers and down when
+ * it falls below minQueuePerServer * servers. This is the original behaviour
+ * of the load balancer.
+ */
+class ThresholdAutoscaler : public Autoscaler {
+    private:
+        int minQueuePerServer;   ///< Per-server queue depth below which a server is removed
+        int maxQueuePerServer;   ///< Per-server queue depth above which a server is added
+
+    public:
+        /**
+         * @brief Constructs the autoscaler from the configured thresholds.
+         * @param config Configuration providing min/maxQueuePerServer.
+         */
+        explicit ThresholdAutoscaler(const Config& config);
+        ScaleDecision decide(int currTime, int queueSize, int serverCount) override;
+        std::string getName() const override;
+};
+
+/**
+ * @class PredictiveAutoscaler
+ * @brief Sizes the pool from the estimated arrival and service rates.
+ *
+ * The arrival rate (requests per cycle) and the mean service time are tracked
+ * as exponentially weighted moving averages. By Little's law the pool keeps
+ * rate * serviceTime servers busy on average; the backlog adds the servers
+ * needed to clear the current queue within drainHorizon cycles. The target is
+ * that demand divided by targetUtilization, and the pool moves toward it by
+ * at most maxScaleStep servers per decision.
+ */
+class PredictiveAutoscaler : public Autoscaler {
+    private:
+        double alpha;               ///< EWMA weight of one cycle's (or one completion's) sample
+        double targetUtilization;   ///< Desired fraction of busy servers, in (0, 1]
+        int drainHorizon;           ///< Cycles within which the current backlog should be cleared
+        int maxScaleStep;           ///< Largest change in server count per decision
+
+        double arrivalRate;         ///< Smoothed arrivals per cycle
+        double serviceTime;         ///< Smoothed service time in cycles, or 0 before the first completion
+        int pendingArrivals;        ///< Arrivals recorded since the rate was last updated
+        int lastUpdate;             ///< Cycle of the last rate update
+
+    public:
+        /**
+         * @brief Constructs the autoscaler from the configured model parameters.
+         * @param config Configuration providing ewmaAlpha, targetUtilization, drainHorizon and maxScaleStep.
+         */
+        explicit PredictiveAutoscaler(const Config& config);
+        void recordArrivals(int count) override;
+        void recordCompletion(int serviceTime) override;
+        ScaleDecision decide(int currTime, int queueSize, int serverCount) override;
+        std::string getName() const override;
+};
+
+#endif
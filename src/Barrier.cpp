@@ -0,0 +1,23 @@
+/**
+ * @file Barrier.cpp
+ * @brief Implementation of the Barrier class.
+ */
+
+#include "Barrier.h"
+
+Barrier::Barrier(int participants) : participants(participants), waiting(0), generation(0) {
+}
+
+void Barrier::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    long long round = generation;
+
+    if (++waiting == participants) {
+        waiting = 0;
+        generation++;
+        released.notify_all();
+        return;
+    }
+
+    released.wait(lock, [this, round] { return generation != round; });
+}
@@ -0,0 +1,42 @@
+/**
+ * @file Barrier.h
+ * @brief Declaration of the Barrier class used to synchronize shard worker threads.
+ */
+
+#ifndef BARRIER_H
+#define BARRIER_H
+
+#include <condition_variable>
+#include <mutex>
+
+/**
+ * @class Barrier
+ * @brief Reusable thread barrier for a fixed number of participants.
+ *
+ * Every call to wait() blocks until all participants have called it, then
+ * releases them together and resets for the next round. The mutex hand-off
+ * also orders memory, so writes made before wait() are visible to every
+ * participant after it returns.
+ */
+class Barrier {
+    private:
+        std::mutex mutex;                 ///< Guards the counters below
+        std::condition_variable released; ///< Signalled when a round completes
+        int participants;                 ///< Number of threads that must arrive each round
+        int waiting;                      ///< Threads that have arrived in the current round
+        long long generation;             ///< Round counter, bumped each time the barrier opens
+
+    public:
+        /**
+         * @brief Constructs a barrier.
+         * @param participants Number of threads that call wait() each round.
+         */
+        explicit Barrier(int participants);
+
+        /**
+         * @brief Blocks until every participant has reached the barrier.
+         */
+        void wait();
+};
+
+#endif
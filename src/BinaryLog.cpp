@@ -0,0 +1,250 @@
+/**
+ * @file BinaryLog.cpp
+ * @brief Implementation of the BinaryLog class.
+ */
+
+#include "BinaryLog.h"
+
+namespace {
+
+/// Largest block payload readBlock() accepts, as a guard against corrupt lengths.
+const uint32_t maxBlockBytes = 1 << 26;
+
+/// Appends an unsigned LEB128 varint.
+void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+/// Appends a zigzag varint, so small negative values stay short.
+void putSigned(std::string& out, int64_t value) {
+    putVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+/// Appends 4 bytes, little-endian.
+void putFixed32(std::string& out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out += static_cast<char>(value >> (8 * i));
+    }
+}
+
+/// Appends a varint length and the bytes.
+void putText(std::string& out, const std::string& text) {
+    putVarint(out, text.size());
+    out += text;
+}
+
+/**
+ * @class Reader
+ * @brief Bounds-checked cursor over a block payload; any overrun marks it failed.
+ */
+class Reader {
+    private:
+        const std::string& data;
+        size_t position;
+        bool failed;
+
+    public:
+        explicit Reader(const std::string& data) : data(data), position(0), failed(false) {}
+
+        bool ok() const { return !failed; }
+        bool done() const { return failed || position == data.size(); }
+
+        uint8_t byte() {
+            if (position >= data.size()) {
+                failed = true;
+                return 0;
+            }
+            return static_cast<uint8_t>(data[position++]);
+        }
+
+        uint64_t varint() {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                uint8_t b = byte();
+                value |= static_cast<uint64_t>(b & 0x7F) << shift;
+                if (!(b & 0x80)) {
+                    return value;
+                }
+            }
+            failed = true;
+            return 0;
+        }
+
+        int64_t signedVarint() {
+            uint64_t value = varint();
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+
+        uint32_t fixed32() {
+            uint32_t value = 0;
+            for (int i = 0; i < 4; i++) {
+                value |= static_cast<uint32_t>(byte()) << (8 * i);
+            }
+            return value;
+        }
+
+        std::string text() {
+            uint64_t length = varint();
+            if (failed || length > data.size() - position) {
+                failed = true;
+                return "";
+            }
+            std::string value = data.substr(position, length);
+            position += length;
+            return value;
+        }
+};
+
+}
+
+const char BinaryLog::magic[8] = {'L', 'B', 'L', 'O', 'G', '\1', '\0', '\0'};
+
+BinaryLog::BinaryLog() : blockRecords(0), lastCycle(0) {
+}
+
+void BinaryLog::append(const LogRecord& record, const std::string& text) {
+    block += static_cast<char>(record.type);
+    putSigned(block, static_cast<int64_t>(record.cycle) - lastCycle);
+    lastCycle = record.cycle;
+    blockRecords++;
+
+    switch (record.type) {
+        case LogEventType::ServerAdded:
+        case LogEventType::ServerRemoved:
+            putSigned(block, record.number);
+            break;
+        case LogEventType::RequestStarted:
+        case LogEventType::RequestProcessed:
+            putSigned(block, record.number);
+            putFixed32(block, record.ipIn);
+            putFixed32(block, record.ipOut);
+            putSigned(block, record.value);
+            break;
+        case LogEventType::RequestBlocked:
+        case LogEventType::RequestRateLimited:
+            putFixed32(block, record.ipIn);
+            break;
+        case LogEventType::RequestShed:
+            putFixed32(block, record.ipIn);
+            putText(block, text);
+            break;
+        case LogEventType::SourceAutoBlocked:
+            putFixed32(block, record.ipIn);
+            putSigned(block, record.value);
+            putSigned(block, record.number);
+            break;
+        case LogEventType::Status:
+            putSigned(block, record.value);
+            putSigned(block, record.number);
+            break;
+        case LogEventType::Event:
+        case LogEventType::TopTalkers:
+        case LogEventType::Text:
+        case LogEventType::Latency:
+            putText(block, text);
+            break;
+    }
+}
+
+size_t BinaryLog::size() const {
+    return block.size();
+}
+
+void BinaryLog::finishBlock(std::string& out) {
+    if (blockRecords == 0) {
+        return;
+    }
+    putFixed32(out, block.size());
+    putFixed32(out, blockRecords);
+    out += block;
+    block.clear();
+    blockRecords = 0;
+    lastCycle = 0;
+}
+
+bool BinaryLog::readMagic(std::istream& in) {
+    char start[sizeof(magic)];
+    if (!in.read(start, sizeof(start))) {
+        return false;
+    }
+    return std::string(start, sizeof(start)) == std::string(magic, sizeof(magic));
+}
+
+bool BinaryLog::readBlock(std::istream& in, std::vector<LoggedEntry>& entries) {
+    entries.clear();
+    unsigned char frame[8];
+    if (!in.read(reinterpret_cast<char*>(frame), sizeof(frame))) {
+        return false;
+    }
+    uint32_t bytes = frame[0] | frame[1] << 8 | frame[2] << 16 | static_cast<uint32_t>(frame[3]) << 24;
+    uint32_t count = frame[4] | frame[5] << 8 | frame[6] << 16 | static_cast<uint32_t>(frame[7]) << 24;
+    if (bytes > maxBlockBytes || count > bytes) {
+        return false;
+    }
+    std::string payload(bytes, '\0');
+    if (!in.read(&payload[0], bytes)) {
+        return false;
+    }
+
+    Reader reader(payload);
+    int cycle = 0;
+    entries.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        LoggedEntry entry{LogRecord{0, LogEventType::Event, 0, 0, 0, 0}, ""};
+        LogRecord& record = entry.record;
+        uint8_t tag = reader.byte();
+        if (tag > static_cast<uint8_t>(LogEventType::Latency)) {
+            return false;
+        }
+        record.type = static_cast<LogEventType>(tag);
+        cycle += reader.signedVarint();
+        record.cycle = cycle;
+
+        switch (record.type) {
+            case LogEventType::ServerAdded:
+            case LogEventType::ServerRemoved:
+                record.number = reader.signedVarint();
+                break;
+            case LogEventType::RequestStarted:
+            case LogEventType::RequestProcessed:
+                record.number = reader.signedVarint();
+                record.ipIn = reader.fixed32();
+                record.ipOut = reader.fixed32();
+                record.value = reader.signedVarint();
+                break;
+            case LogEventType::RequestBlocked:
+            case LogEventType::RequestRateLimited:
+                record.ipIn = reader.fixed32();
+                break;
+            case LogEventType::RequestShed:
+                record.ipIn = reader.fixed32();
+                record.value = -1;
+                entry.text = reader.text();
+                break;
+            case LogEventType::SourceAutoBlocked:
+                record.ipIn = reader.fixed32();
+                record.value = reader.signedVarint();
+                record.number = reader.signedVarint();
+                break;
+            case LogEventType::Status:
+                record.value = reader.signedVarint();
+                record.number = reader.signedVarint();
+                break;
+            case LogEventType::Event:
+            case LogEventType::TopTalkers:
+            case LogEventType::Text:
+            case LogEventType::Latency:
+                entry.text = reader.text();
+                break;
+        }
+        if (!reader.ok()) {
+            return false;
+        }
+        entries.push_back(std::move(entry));
+    }
+    return reader.done();
+}
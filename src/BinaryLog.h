@@ -0,0 +1,90 @@
+/**
+ * @file BinaryLog.h
+ * @brief Declaration of the BinaryLog class, the compact encoding of log records written with logFormat=binary.
+ */
+
+#ifndef BINARYLOG_H
+#define BINARYLOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+#include "LogRing.h"
+
+/**
+ * @struct LoggedEntry
+ * @brief A decoded log record with the free text it carried, if any.
+ */
+struct LoggedEntry {
+    LogRecord record;   ///< Decoded record; a shed record's reason is in text (value is -1)
+    std::string text;   ///< Event message, shed reason, top-talker list, latency percentiles or file text of a Text record
+};
+
+/**
+ * @class BinaryLog
+ * @brief Encodes log records into self-contained blocks and decodes them back.
+ *
+ * A binary log is the 8-byte magic followed by blocks. Each block is a
+ * 4-byte little-endian payload length, a 4-byte record count and the
+ * payload, so a reader can skip or stop at any block boundary and a run cut
+ * short loses at most the block being written. In the payload each record
+ * is a one-byte LogEventType tag, the zigzag varint change in cycle from
+ * the previous record of the block (the first is relative to 0), then only
+ * the fields its type uses: server ids, counts and times as varints, IPv4
+ * addresses as 4 raw bytes, and text as a varint length and the bytes.
+ * A request start or completion takes 12 bytes against about 100 as
+ * a text line.
+ *
+ * A Text record (the header or summary) keeps only its file text; the
+ * console version is not stored.
+ */
+class BinaryLog {
+    private:
+        std::string block;        ///< Payload of the block being built
+        uint32_t blockRecords;    ///< Records in the block being built
+        int lastCycle;            ///< Cycle of the block's last record
+
+    public:
+        static const char magic[8];   ///< First bytes of every binary log
+
+        /** @brief Creates an encoder with an empty block. */
+        BinaryLog();
+
+        /**
+         * @brief Encodes a record into the current block.
+         * @param record Record to encode; for RequestShed the reason is taken from text.
+         * @param text Free text the record carries (ignored by types without text).
+         */
+        void append(const LogRecord& record, const std::string& text);
+
+        /** @brief Returns the payload bytes of the current block. */
+        size_t size() const;
+
+        /**
+         * @brief Appends the current block, framed, to out and starts a new one.
+         *
+         * Does nothing if the block is empty.
+         *
+         * @param out Receives the framed block.
+         */
+        void finishBlock(std::string& out);
+
+        /**
+         * @brief Reads and checks the magic at the start of a binary log.
+         * @param in Stream positioned at the start of the log.
+         * @return true if the magic matches.
+         */
+        static bool readMagic(std::istream& in);
+
+        /**
+         * @brief Reads and decodes the next block.
+         * @param in Stream positioned at a block boundary.
+         * @param entries Receives the block's records, replacing its contents.
+         * @return true if a block was decoded, false at the end of the log or on a truncated or corrupt block.
+         */
+        static bool readBlock(std::istream& in, std::vector<LoggedEntry>& entries);
+};
+
+#endif
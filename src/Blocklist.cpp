@@ -0,0 +1,67 @@
+/**
+ * @file Blocklist.cpp
+ * @brief Implementation of the Blocklist class.
+ */
+
+#include "Blocklist.h"
+#include <algorithm>
+
+Blocklist::Blocklist() : nodes(1) {
+}
+
+Blocklist::Blocklist(const std::vector<IpRange>& ranges) {
+    std::vector<Interval> sorted;
+    sorted.reserve(ranges.size());
+    for (const IpRange& range : ranges) {
+        // an inverted range never matched anything, so it is left out
+        if (range.getStartAddress() <= range.getEndAddress()) {
+            sorted.push_back(Interval{range.getStartAddress(), range.getEndAddress()});
+        }
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Interval& a, const Interval& b) {
+        return a.start < b.start;
+    });
+
+    size_t merged = 0;
+    for (size_t i = 0; i < sorted.size(); i++) {
+        // adjacent intervals merge too; the 64-bit sum keeps 255.255.255.255 from wrapping
+        if (merged > 0 && sorted[i].start <= static_cast<uint64_t>(sorted[merged - 1].end) + 1) {
+            sorted[merged - 1].end = std::max(sorted[merged - 1].end, sorted[i].end);
+        } else {
+            sorted[merged++] = sorted[i];
+        }
+    }
+    sorted.resize(merged);
+
+    nodes.resize(merged + 1);
+    size_t next = 0;
+    layout(sorted, next, 1);
+}
+
+void Blocklist::layout(const std::vector<Interval>& sorted, size_t& next, size_t k) {
+    if (k < nodes.size()) {
+        layout(sorted, next, 2 * k);
+        nodes[k] = sorted[next++];
+        layout(sorted, next, 2 * k + 1);
+    }
+}
+
+bool Blocklist::contains(uint32_t ip) const {
+    size_t n = nodes.size() - 1;
+    size_t k = 1;
+    const Interval* base = nodes.data();
+    while (k <= n) {
+        // k's 16 descendants four levels down are adjacent; start loading them while this level resolves.
+        // The address is formed as an integer because it may lie past the end of the array.
+        __builtin_prefetch(reinterpret_cast<const void*>(reinterpret_cast<uintptr_t>(base) + 16 * k * sizeof(Interval)));
+        k = 2 * k + (base[k].end < ip);
+    }
+    // the low bits record the turns taken; dropping the trailing right turns and the last left one
+    // leaves the node where the search last went left, the first interval ending at or after ip
+    k >>= __builtin_ffsll(~static_cast<long long>(k));
+    return k != 0 && nodes[k].start <= ip;
+}
+
+size_t Blocklist::intervalCount() const {
+    return nodes.size() - 1;
+}
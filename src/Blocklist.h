@@ -0,0 +1,76 @@
+/**
+ * @file Blocklist.h
+ * @brief Declaration of the Blocklist class, a compiled lookup structure for blocked IPv4 ranges.
+ */
+
+#ifndef BLOCKLIST_H
+#define BLOCKLIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "IpRange.h"
+
+/**
+ * @class Blocklist
+ * @brief Set of blocked IPv4 addresses, compiled from IpRanges for fast membership tests.
+ *
+ * At construction the ranges are sorted and every overlapping or adjacent
+ * pair is merged, leaving disjoint intervals whose starts and ends are both
+ * increasing. The intervals are stored in Eytzinger (BFS heap) order: node k
+ * has children 2k and 2k + 1, so the first levels of every search share the
+ * same few cache lines.
+ *
+ * contains() finds the first interval whose end is not below the address
+ * with a fixed-length descent that uses the comparison result as an index
+ * offset instead of a branch, then checks that interval's start. The cost
+ * is log2(intervals) + 1 steps whatever the address.
+ */
+class Blocklist {
+    private:
+        /**
+         * @struct Interval
+         * @brief One merged, inclusive address interval.
+         */
+        struct Interval {
+            uint32_t start;   ///< First blocked address
+            uint32_t end;     ///< Last blocked address
+        };
+
+        std::vector<Interval> nodes;   ///< Intervals in Eytzinger order, 1-based; nodes[0] is unused
+
+        /**
+         * @brief Places sorted intervals into nodes in Eytzinger order.
+         * @param sorted Merged intervals in increasing order.
+         * @param next Index of the next sorted interval to place.
+         * @param k Eytzinger node to fill, with its subtree.
+         */
+        void layout(const std::vector<Interval>& sorted, size_t& next, size_t k);
+
+    public:
+        /**
+         * @brief Creates an empty blocklist that blocks nothing.
+         */
+        Blocklist();
+
+        /**
+         * @brief Compiles a blocklist from inclusive ranges.
+         * @param ranges Ranges to block, in any order and possibly overlapping.
+         */
+        explicit Blocklist(const std::vector<IpRange>& ranges);
+
+        /**
+         * @brief Checks whether an address is blocked.
+         * @param ip IPv4 address in host byte order.
+         * @return true if ip lies in any blocked range.
+         */
+        bool contains(uint32_t ip) const;
+
+        /**
+         * @brief Returns the number of disjoint intervals left after merging.
+         * @return Interval count.
+         */
+        size_t intervalCount() const;
+};
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * @file BlocklistWatcher.cpp
+ * @brief Implementation of the BlocklistWatcher class.
+ */
+
+#include "BlocklistWatcher.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sys/stat.h>
+
+bool BlocklistWatcher::FileStamp::matches(const FileStamp& other) const {
+    return exists == other.exists && modifiedNanos == other.modifiedNanos && size == other.size;
+}
+
+BlocklistWatcher::BlocklistWatcher(const Config& config, int reloadInterval)
+    : current(nullptr), epoch(0), configFile(config.getSourceFile()), listFile(config.getBlocklistFile()),
+      ranges(config.getBlockedIpRanges()), reloadInterval(std::max(reloadInterval, 1)), reloads(0), stopping(false) {
+        readers[0].count = 0;
+        readers[1].count = 0;
+        configStamp = stampOf(configFile);
+        listStamp = stampOf(listFile);
+
+        CidrTrie* table = compile(ranges, listFile);
+        if (!table) {
+            // start from the ranges alone; the next successful reload brings in the file
+            table = compile(ranges, "");
+        }
+        current = table;
+        thread = std::thread(&BlocklistWatcher::run, this);
+    }
+
+BlocklistWatcher::~BlocklistWatcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    thread.join();
+    delete current.load();
+}
+
+BlocklistWatcher::FileStamp BlocklistWatcher::stampOf(const std::string& filename) {
+    struct stat info;
+    if (filename.empty() || stat(filename.c_str(), &info) != 0) {
+        return FileStamp{false, 0, 0};
+    }
+    long long modified = static_cast<long long>(info.st_mtim.tv_sec) * 1000000000LL + info.st_mtim.tv_nsec;
+    return FileStamp{true, modified, static_cast<long long>(info.st_size)};
+}
+
+CidrTrie* BlocklistWatcher::compile(const std::vector<IpRange>& ranges, const std::string& filename) {
+    CidrTrie* table = new CidrTrie();
+    if (!filename.empty() && !table->loadFile(filename)) {
+        std::cerr << "Could not read blocklist file " << filename << std::endl;
+        delete table;
+        return nullptr;
+    }
+    for (const IpRange& range : ranges) {
+        table->addRange(range.getStartAddress(), range.getEndAddress());
+    }
+    table->build();
+    return table;
+}
+
+void BlocklistWatcher::run() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (wake.wait_for(lock, std::chrono::milliseconds(reloadInterval), [this] { return stopping; })) {
+                return;
+            }
+        }
+
+        bool changed;
+        {
+            std::lock_guard<std::mutex> lock(reloadMutex);
+            changed = !stampOf(configFile).matches(configStamp) || !stampOf(listFile).matches(listStamp);
+        }
+        if (changed) {
+            reload();
+        }
+    }
+}
+
+bool BlocklistWatcher::reload() {
+    std::lock_guard<std::mutex> lock(reloadMutex);
+    // stamp before reading, so an edit made while reading is picked up by the next check;
+    // a failed reload is not retried until the files change again
+    configStamp = stampOf(configFile);
+    if (!configFile.empty()) {
+        Config fresh;
+        if (!fresh.loadFromFile(configFile)) {
+            return false;
+        }
+        ranges = fresh.getBlockedIpRanges();
+        listFile = fresh.getBlocklistFile();
+    }
+    listStamp = stampOf(listFile);
+
+    CidrTrie* table = compile(ranges, listFile);
+    if (!table) {
+        return false;
+    }
+    publish(table);
+    reloads++;
+    return true;
+}
+
+void BlocklistWatcher::publish(const CidrTrie* table) {
+    const CidrTrie* old = current.exchange(table);
+    // readers registering from here on use the other side and can only load the new table
+    unsigned int side = epoch.fetch_add(1) & 1;
+    while (readers[side].count.load() != 0) {
+        std::this_thread::yield();
+    }
+    delete old;
+}
+
+bool BlocklistWatcher::contains(uint32_t ip) const {
+    unsigned int side = epoch.load() & 1;
+    readers[side].count.fetch_add(1);
+    // a flip between the two epoch loads may already have been waited out, so register again
+    while ((epoch.load() & 1) != side) {
+        readers[side].count.fetch_sub(1);
+        side ^= 1;
+        readers[side].count.fetch_add(1);
+    }
+    bool blocked = current.load()->containsV4(ip);
+    readers[side].count.fetch_sub(1);
+    return blocked;
+}
+
+int BlocklistWatcher::getReloadCount() const {
+    return reloads;
+}
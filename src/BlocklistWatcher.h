@@ -0,0 +1,150 @@
+/**
+ * @file BlocklistWatcher.h
+ * @brief Declaration of the BlocklistWatcher class, which reloads the blocklist while the simulation runs.
+ */
+
+#ifndef BLOCKLISTWATCHER_H
+#define BLOCKLISTWATCHER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CidrTrie.h"
+#include "Config.h"
+#include "IpRange.h"
+
+/**
+ * @class BlocklistWatcher
+ * @brief Blocklist that a background thread rebuilds whenever its source files change.
+ *
+ * The sources are the config file's blockedIpRanges and the prefix file
+ * named by its blocklistFile. Every reloadInterval milliseconds the watcher
+ * thread compares the files' modification times and sizes with those of the
+ * last build; on a change it re-reads both into a new CidrTrie, compiles it,
+ * and only then publishes it by swapping one atomic pointer. A reader sees
+ * either the old table or the new one, never a partial build.
+ *
+ * Old tables are reclaimed with two-sided epoch counting. A reader registers
+ * on the side given by the epoch's parity, rechecking the parity afterwards,
+ * and loads the table pointer only once registered. After a swap the watcher
+ * flips the epoch and waits for the side that was current to drain: every
+ * reader still on it may hold the old table, and every later reader loads
+ * the new one. Readers never wait for the watcher; only the watcher waits,
+ * for lookups already in progress.
+ *
+ * If a source cannot be read the current table stays in place and the
+ * failure is reported on std::cerr.
+ */
+class BlocklistWatcher {
+    private:
+        /**
+         * @struct FileStamp
+         * @brief What a file looked like at the last build, to detect edits cheaply.
+         */
+        struct FileStamp {
+            bool exists;              ///< Whether stat() found the file
+            long long modifiedNanos;  ///< Last modification time in nanoseconds
+            long long size;           ///< Size in bytes
+
+            /** @brief Returns true if other describes the same file state. */
+            bool matches(const FileStamp& other) const;
+        };
+
+        /**
+         * @struct ReaderCount
+         * @brief Number of lookups registered on one side of the epoch, alone on its cache line.
+         */
+        struct alignas(64) ReaderCount {
+            std::atomic<int> count;   ///< Lookups in progress on this side
+        };
+
+        std::atomic<const CidrTrie*> current;     ///< Published table; never null
+        std::atomic<unsigned int> epoch;          ///< Parity selects the side new readers register on
+        mutable ReaderCount readers[2];           ///< Lookups in progress per epoch side
+        std::string configFile;                   ///< Config file supplying blockedIpRanges (empty = none)
+        std::string listFile;                     ///< Prefix file named by the last loaded config (empty = none)
+        std::vector<IpRange> ranges;              ///< Blocked ranges from the last loaded config
+        FileStamp configStamp;                    ///< configFile as of the last build
+        FileStamp listStamp;                      ///< listFile as of the last build
+        int reloadInterval;                       ///< Milliseconds between checks of the source files
+        std::atomic<int> reloads;                 ///< Tables published after the initial one
+        std::mutex reloadMutex;                   ///< Serializes reloads and guards the file fields above
+        std::mutex mutex;                         ///< Guards stopping
+        std::condition_variable wake;             ///< Signalled to stop the watcher thread early
+        bool stopping;                            ///< Set when the watcher thread should exit
+        std::thread thread;                       ///< Background thread polling the sources
+
+        /**
+         * @brief Reads a file's modification time and size.
+         * @param filename File to examine; an empty name never exists.
+         * @return Stamp of the file.
+         */
+        static FileStamp stampOf(const std::string& filename);
+
+        /**
+         * @brief Compiles ranges and a prefix file into a new table.
+         * @param ranges Blocked IP ranges.
+         * @param filename Prefix file, or an empty string for none.
+         * @return The compiled table, or nullptr if the prefix file could not be read.
+         */
+        static CidrTrie* compile(const std::vector<IpRange>& ranges, const std::string& filename);
+
+        /**
+         * @brief Body of the watcher thread: polls the sources until stopped.
+         */
+        void run();
+
+        /**
+         * @brief Swaps in a new table, then frees the old one once no lookup can still be using it.
+         * @param table Compiled table to publish; ownership passes to the watcher.
+         */
+        void publish(const CidrTrie* table);
+
+    public:
+        /**
+         * @brief Builds the initial table from a configuration and starts watching its sources.
+         * @param config Configuration supplying the ranges, the prefix file and the config file name.
+         * @param reloadInterval Milliseconds between checks of the source files.
+         */
+        BlocklistWatcher(const Config& config, int reloadInterval);
+
+        BlocklistWatcher(const BlocklistWatcher&) = delete;
+        BlocklistWatcher& operator=(const BlocklistWatcher&) = delete;
+
+        /**
+         * @brief Stops the watcher thread and frees the current table.
+         */
+        ~BlocklistWatcher();
+
+        /**
+         * @brief Checks whether an address is blocked by the current table. Safe to call from any thread.
+         *
+         * Never blocks: it only retries its registration if the epoch flips
+         * under it.
+         *
+         * @param ip IPv4 address in host byte order.
+         * @return true if the address is blocked.
+         */
+        bool contains(uint32_t ip) const;
+
+        /**
+         * @brief Re-reads the sources now and publishes the result, whether or not they changed.
+         *
+         * Called by the watcher thread on a change; may also be called from
+         * any other thread, and waits for a reload already in progress.
+         *
+         * @return true if a new table was published, false if a source could not be read.
+         */
+        bool reload();
+
+        /**
+         * @brief Returns how many tables were published after the initial one.
+         * @return Reload count.
+         */
+        int getReloadCount() const;
+};
+
+#endif
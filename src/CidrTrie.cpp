@@ -0,0 +1,291 @@
+/**
+ * @file CidrTrie.cpp
+ * @brief Implementation of the CidrTrie class.
+ */
+
+#include "CidrTrie.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+const int stride = 6;   ///< Address bits consumed per trie level
+
+/**
+ * @brief Returns a mask of the slots at or below slot in a 64-bit bitmap.
+ */
+uint64_t upTo(int slot) {
+    return slot == 63 ? ~0ULL : (2ULL << slot) - 1;
+}
+
+}
+
+CidrTrie::CidrTrie() : prefixCount(0) {
+    v4.keyBits = 32;
+    v6.keyBits = 128;
+    buildFamily(v4);
+    buildFamily(v6);
+}
+
+bool CidrTrie::addPrefix(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos) {
+        return false;
+    }
+    size_t last = text.find_last_not_of(" \t\r");
+    std::string prefix = text.substr(first, last - first + 1);
+
+    std::string address = prefix;
+    int length = -1;
+    size_t slash = prefix.find('/');
+    if (slash != std::string::npos) {
+        address = prefix.substr(0, slash);
+        std::string lengthText = prefix.substr(slash + 1);
+        if (lengthText.empty() || lengthText.size() > 3 || lengthText.find_first_not_of("0123456789") != std::string::npos) {
+            return false;
+        }
+        length = std::stoi(lengthText);
+    }
+
+    Family* family;
+    Key key = 0;
+    if (address.find(':') == std::string::npos) {
+        in_addr parsed;
+        if (inet_pton(AF_INET, address.c_str(), &parsed) != 1) {
+            return false;
+        }
+        key = ntohl(parsed.s_addr);
+        family = &v4;
+    } else {
+        in6_addr parsed;
+        if (inet_pton(AF_INET6, address.c_str(), &parsed) != 1) {
+            return false;
+        }
+        for (int i = 0; i < 16; i++) {
+            key = (key << 8) | parsed.s6_addr[i];
+        }
+        family = &v6;
+    }
+
+    if (length < 0) {
+        length = family->keyBits;
+    }
+    if (length > family->keyBits) {
+        return false;
+    }
+    // host bits below the prefix length are ignored, as routers do
+    int hostBits = family->keyBits - length;
+    Key span = hostBits == 128 ? ~static_cast<Key>(0) : (static_cast<Key>(1) << hostBits) - 1;
+    Key start = key & ~span;
+    family->pending.push_back(Interval{start, start + span});
+    prefixCount++;
+    return true;
+}
+
+void CidrTrie::addRange(uint32_t start, uint32_t end) {
+    if (start <= end) {
+        v4.pending.push_back(Interval{start, end});
+        prefixCount++;
+    }
+}
+
+bool CidrTrie::loadFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    int skipped = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        if (!addPrefix(line)) {
+            if (skipped < 5) {
+                std::cerr << filename << ":" << lineNumber << ": invalid prefix '" << line << "'" << std::endl;
+            }
+            skipped++;
+        }
+    }
+    if (skipped > 0) {
+        std::cerr << filename << ": skipped " << skipped << " invalid line(s)" << std::endl;
+    }
+    return true;
+}
+
+void CidrTrie::build() {
+    buildFamily(v4);
+    buildFamily(v6);
+}
+
+void CidrTrie::buildFamily(Family& family) {
+    std::vector<Interval> merged;
+    collect(family, merged);
+    merged.insert(merged.end(), family.pending.begin(), family.pending.end());
+    std::vector<Interval>().swap(family.pending);
+
+    std::sort(merged.begin(), merged.end(), [](const Interval& a, const Interval& b) {
+        return a.start < b.start;
+    });
+    size_t count = 0;
+    for (size_t i = 0; i < merged.size(); i++) {
+        // adjacent intervals merge too; an end at the top of the address space cannot be extended
+        Key maxKey = family.keyBits == 128 ? ~static_cast<Key>(0) : (static_cast<Key>(1) << family.keyBits) - 1;
+        if (count > 0 && (merged[count - 1].end == maxKey || merged[i].start <= merged[count - 1].end + 1)) {
+            merged[count - 1].end = std::max(merged[count - 1].end, merged[i].end);
+        } else {
+            merged[count++] = merged[i];
+        }
+    }
+    merged.resize(count);
+
+    family.nodes.assign(1, Node{0, 0, 0, 0});
+    family.leaves.clear();
+    family.intervals = count;
+    buildNode(family, 0, 0, 0, merged, 0);
+    family.nodes.shrink_to_fit();
+    family.leaves.shrink_to_fit();
+}
+
+void CidrTrie::buildNode(Family& family, size_t index, Key base, int offset,
+                         const std::vector<Interval>& merged, size_t cursor) {
+    int bits = std::min(stride, family.keyBits - offset);
+    int slots = 1 << bits;
+    int slotBits = family.keyBits - offset - bits;
+    Key slotSpan = slotBits == 128 ? ~static_cast<Key>(0) : (static_cast<Key>(1) << slotBits) - 1;
+
+    uint64_t vector = 0;
+    uint64_t leafvec = 0;
+    size_t childCursor[64];
+    int previousLeaf = -1;
+    for (int slot = 0; slot < slots; slot++) {
+        Key low = base + (static_cast<Key>(slot) << slotBits);
+        Key high = low + slotSpan;
+        while (cursor < merged.size() && merged[cursor].end < low) {
+            cursor++;
+        }
+
+        int leaf;
+        if (cursor == merged.size() || merged[cursor].start > high) {
+            leaf = 0;
+        } else if (merged[cursor].start <= low && merged[cursor].end >= high) {
+            leaf = 1;
+        } else {
+            vector |= 1ULL << slot;
+            childCursor[slot] = cursor;
+            continue;
+        }
+        if (leaf != previousLeaf) {
+            leafvec |= 1ULL << slot;
+            family.leaves.push_back(leaf);
+            previousLeaf = leaf;
+        }
+    }
+
+    Node& node = family.nodes[index];
+    node.vector = vector;
+    node.leafvec = leafvec;
+    node.base0 = family.leaves.size() - __builtin_popcountll(leafvec);
+    node.base1 = family.nodes.size();
+
+    // the children are allocated together so each is found by position; then each fills its own subtree
+    size_t firstChild = family.nodes.size();
+    family.nodes.resize(firstChild + __builtin_popcountll(vector), Node{0, 0, 0, 0});
+    size_t child = firstChild;
+    for (int slot = 0; slot < slots; slot++) {
+        if (vector & (1ULL << slot)) {
+            buildNode(family, child++, base + (static_cast<Key>(slot) << slotBits), offset + bits, merged, childCursor[slot]);
+        }
+    }
+}
+
+bool CidrTrie::lookup(const Family& family, Key key) {
+    const Node* nodes = family.nodes.data();
+    size_t index = 0;
+    int offset = 0;
+    while (true) {
+        const Node& node = nodes[index];
+        int bits = std::min(stride, family.keyBits - offset);
+        int slot = static_cast<int>(key >> (family.keyBits - offset - bits)) & ((1 << bits) - 1);
+        if (node.vector & (1ULL << slot)) {
+            index = node.base1 + __builtin_popcountll(node.vector & upTo(slot)) - 1;
+            offset += bits;
+            continue;
+        }
+        return family.leaves[node.base0 + __builtin_popcountll(node.leafvec & upTo(slot)) - 1];
+    }
+}
+
+void CidrTrie::collect(const Family& family, std::vector<Interval>& out) {
+    if (family.nodes.empty()) {
+        return;
+    }
+    // iterative depth-first walk in address order; each frame is a node, its first address, depth and next slot
+    struct Frame {
+        size_t index;
+        Key base;
+        int offset;
+        int slot;
+    };
+    std::vector<Frame> stack;
+    stack.push_back(Frame{0, 0, 0, 0});
+    while (!stack.empty()) {
+        Frame& frame = stack.back();
+        int bits = std::min(stride, family.keyBits - frame.offset);
+        if (frame.slot == (1 << bits)) {
+            stack.pop_back();
+            continue;
+        }
+        const Node& node = family.nodes[frame.index];
+        int slot = frame.slot++;
+        int slotBits = family.keyBits - frame.offset - bits;
+        Key low = frame.base + (static_cast<Key>(slot) << slotBits);
+        if (node.vector & (1ULL << slot)) {
+            size_t child = node.base1 + __builtin_popcountll(node.vector & upTo(slot)) - 1;
+            stack.push_back(Frame{child, low, frame.offset + bits, 0});
+            continue;
+        }
+        if (!family.leaves[node.base0 + __builtin_popcountll(node.leafvec & upTo(slot)) - 1]) {
+            continue;
+        }
+        Key high = low + (slotBits == 128 ? ~static_cast<Key>(0) : (static_cast<Key>(1) << slotBits) - 1);
+        if (!out.empty() && out.back().end + 1 == low) {
+            out.back().end = high;
+        } else {
+            out.push_back(Interval{low, high});
+        }
+    }
+}
+
+bool CidrTrie::containsV4(uint32_t ip) const {
+    return lookup(v4, ip);
+}
+
+bool CidrTrie::containsV6(const uint8_t* ip) const {
+    Key key = 0;
+    for (int i = 0; i < 16; i++) {
+        key = (key << 8) | ip[i];
+    }
+    return lookup(v6, key);
+}
+
+size_t CidrTrie::getPrefixCount() const {
+    return prefixCount;
+}
+
+size_t CidrTrie::getIntervalCount() const {
+    return v4.intervals + v6.intervals;
+}
+
+size_t CidrTrie::getMemoryBytes() const {
+    return (v4.nodes.size() + v6.nodes.size()) * sizeof(Node) + v4.leaves.size() + v6.leaves.size();
+}
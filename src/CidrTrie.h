@@ -0,0 +1,168 @@
+/**
+ * @file CidrTrie.h
+ * @brief Declaration of the CidrTrie class, a compressed multibit trie of blocked IPv4 and IPv6 prefixes.
+ */
+
+#ifndef CIDRTRIE_H
+#define CIDRTRIE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class CidrTrie
+ * @brief Blocklist of CIDR prefixes and address ranges with bounded-time lookups, after Poptrie.
+ *
+ * Each address family is a trie with 6-bit strides. A node holds two 64-bit
+ * bitmaps over its 64 slots: `vector` marks the slots that continue into a
+ * child node, and `leafvec` marks the slots where a run of equal leaves
+ * begins. Children and leaves of a node are stored contiguously, so the
+ * position of either is its base plus a population count of the bitmap
+ * below the slot. A lookup visits at most 6 nodes for IPv4 and 22 for IPv6,
+ * whatever the number of prefixes.
+ *
+ * Prefixes and ranges are collected first and compiled by build(): they are
+ * sorted and merged into disjoint intervals, and each node is emitted
+ * directly from the intervals it overlaps. A slot becomes a child only if an
+ * interval boundary falls inside it, so the trie never materializes an
+ * uncompressed node and its size follows the number of boundaries.
+ *
+ * The file format is one prefix per line, such as "10.0.0.0/8",
+ * "192.0.2.7" (a /32) or "2001:db8::/32"; blank lines and text after '#'
+ * are ignored.
+ */
+class CidrTrie {
+    private:
+        typedef unsigned __int128 Key;   ///< Address as a 128-bit integer; IPv4 uses the low 32 bits
+
+        /**
+         * @struct Node
+         * @brief One trie node covering 64 slots (fewer on the last level).
+         */
+        struct Node {
+            uint64_t vector;    ///< Slots that continue into a child node
+            uint64_t leafvec;   ///< Leaf slots that start a new run of leaf values
+            uint32_t base0;     ///< Index of the node's first leaf
+            uint32_t base1;     ///< Index of the node's first child
+        };
+
+        /**
+         * @struct Interval
+         * @brief Inclusive address interval awaiting compilation.
+         */
+        struct Interval {
+            Key start;   ///< First blocked address
+            Key end;     ///< Last blocked address
+        };
+
+        /**
+         * @struct Family
+         * @brief Compiled trie and pending input for one address family.
+         */
+        struct Family {
+            int keyBits;                     ///< Address width: 32 or 128
+            std::vector<Node> nodes;         ///< Compiled nodes; nodes[0] is the root
+            std::vector<uint8_t> leaves;     ///< Leaf values: 1 for blocked
+            std::vector<Interval> pending;   ///< Intervals added since the last build()
+            size_t intervals;                ///< Disjoint intervals in the compiled trie
+        };
+
+        Family v4;            ///< IPv4 trie
+        Family v6;            ///< IPv6 trie
+        size_t prefixCount;   ///< Prefixes and ranges added so far
+
+        /**
+         * @brief Compiles a family's pending intervals, together with its current contents, into a new trie.
+         * @param family Family to compile.
+         */
+        static void buildFamily(Family& family);
+
+        /**
+         * @brief Emits the node covering the addresses that share the first offset bits of base.
+         * @param family Family being compiled.
+         * @param index Index of the node to fill; already allocated.
+         * @param base First address covered by the node.
+         * @param offset Number of address bits consumed above this node.
+         * @param merged Disjoint intervals in increasing order.
+         * @param cursor Index of the first interval that may overlap the node.
+         */
+        static void buildNode(Family& family, size_t index, Key base, int offset,
+                              const std::vector<Interval>& merged, size_t cursor);
+
+        /**
+         * @brief Looks an address up in a compiled family.
+         * @param family Family to search.
+         * @param key Address to look up.
+         * @return true if the address is blocked.
+         */
+        static bool lookup(const Family& family, Key key);
+
+        /**
+         * @brief Reads the intervals of a compiled family back out of its trie.
+         * @param family Family to read.
+         * @param out Receives the blocked intervals in increasing order.
+         */
+        static void collect(const Family& family, std::vector<Interval>& out);
+
+    public:
+        /**
+         * @brief Creates an empty trie that blocks nothing.
+         */
+        CidrTrie();
+
+        /**
+         * @brief Adds one prefix in text form; takes effect at the next build().
+         * @param text Prefix such as "10.0.0.0/8", "192.0.2.7" or "2001:db8::/32".
+         * @return true if the text was a valid prefix, false otherwise.
+         */
+        bool addPrefix(const std::string& text);
+
+        /**
+         * @brief Adds an inclusive IPv4 range; takes effect at the next build().
+         * @param start First address, in host byte order.
+         * @param end Last address, in host byte order.
+         */
+        void addRange(uint32_t start, uint32_t end);
+
+        /**
+         * @brief Streams a prefix file and adds every prefix in it; takes effect at the next build().
+         *
+         * Malformed lines are skipped and reported on std::cerr.
+         *
+         * @param filename Path of the prefix file.
+         * @return true if the file could be read, false otherwise.
+         */
+        bool loadFile(const std::string& filename);
+
+        /**
+         * @brief Compiles everything added so far into the lookup tries.
+         */
+        void build();
+
+        /**
+         * @brief Checks whether an IPv4 address is blocked.
+         * @param ip Address in host byte order.
+         * @return true if the address is covered by a prefix or range.
+         */
+        bool containsV4(uint32_t ip) const;
+
+        /**
+         * @brief Checks whether an IPv6 address is blocked.
+         * @param ip The 16 address bytes in network order.
+         * @return true if the address is covered by a prefix.
+         */
+        bool containsV6(const uint8_t* ip) const;
+
+        /** @brief Returns the number of prefixes and ranges added. */
+        size_t getPrefixCount() const;
+
+        /** @brief Returns the number of disjoint intervals in the compiled tries. */
+        size_t getIntervalCount() const;
+
+        /** @brief Returns the bytes used by the compiled tries. */
+        size_t getMemoryBytes() const;
+};
+
+#endif
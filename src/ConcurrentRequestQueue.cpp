@@ -0,0 +1,80 @@
+/**
+ * @file ConcurrentRequestQueue.cpp
+ * @brief Implementation of the ConcurrentRequestQueue class.
+ */
+
+#include "ConcurrentRequestQueue.h"
+#include <cstdint>
+
+ConcurrentRequestQueue::ConcurrentRequestQueue(int capacity) : enqueuePos(0), dequeuePos(0) {
+    size_t size = 2;
+    while (size < static_cast<size_t>(capacity > 0 ? capacity : 0)) {
+        size *= 2;
+    }
+    cells.reset(new Cell[size]);
+    mask = size - 1;
+    for (size_t i = 0; i < size; i++) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool ConcurrentRequestQueue::tryPush(const Request& request) {
+    Cell* cell;
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &cells[pos & mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // the cell still holds the request from one lap ago
+            return false;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+    cell->request = request;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool ConcurrentRequestQueue::tryPop(Request& out) {
+    Cell* cell;
+    size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &cells[pos & mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0) {
+            if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // nothing has been published at this position yet
+            return false;
+        } else {
+            pos = dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+    out = cell->request;
+    cell->sequence.store(pos + mask + 1, std::memory_order_release);
+    return true;
+}
+
+int ConcurrentRequestQueue::sizeApprox() const {
+    // the two counters are read at different moments, so the difference can briefly fall outside [0, capacity]
+    size_t dequeued = dequeuePos.load(std::memory_order_relaxed);
+    size_t enqueued = enqueuePos.load(std::memory_order_relaxed);
+    intptr_t size = static_cast<intptr_t>(enqueued - dequeued);
+    if (size < 0) {
+        return 0;
+    }
+    return size > static_cast<intptr_t>(mask + 1) ? mask + 1 : size;
+}
+
+int ConcurrentRequestQueue::capacity() const {
+    return mask + 1;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file ConcurrentRequestQueue.h
+ * @brief Declaration of the ConcurrentRequestQueue class, a bounded lock-free MPMC queue of requests.
+ */
+
+#ifndef CONCURRENTREQUESTQUEUE_H
+#define CONCURRENTREQUESTQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include "Request.h"
+
+/**
+ * @class ConcurrentRequestQueue
+ * @brief Bounded FIFO that any number of threads may push to and pop from without locking.
+ *
+ * Follows Dmitry Vyukov's bounded MPMC design: a power-of-two array of cells,
+ * each tagged with a sequence number that says whether the cell is ready to
+ * be written for a given enqueue position or read for a given dequeue
+ * position. A producer claims a position with one compare-and-swap on the
+ * enqueue counter, writes the request, then publishes it by advancing the
+ * cell's sequence; consumers mirror this on the dequeue counter. Producers
+ * only contend with each other on the counter, never with consumers.
+ *
+ * tryPush() and tryPop() never block: they fail when the queue is full or
+ * empty. sizeApprox() reads the two counters without synchronizing with
+ * either side, so it may be stale but is always in [0, capacity()].
+ */
+class ConcurrentRequestQueue {
+    private:
+        /**
+         * @struct Cell
+         * @brief One slot of the ring and the sequence number guarding it.
+         */
+        struct Cell {
+            std::atomic<size_t> sequence;   ///< Position this cell is ready for (write) or position + 1 (read)
+            Request request;                ///< Request stored in the cell
+        };
+
+        std::unique_ptr<Cell[]> cells;                ///< Ring of cells; the count is a power of two
+        size_t mask;                                  ///< Number of cells - 1
+        alignas(64) std::atomic<size_t> enqueuePos;   ///< Next position a producer will claim
+        alignas(64) std::atomic<size_t> dequeuePos;   ///< Next position a consumer will claim
+
+    public:
+        /**
+         * @brief Creates an empty queue.
+         * @param capacity Requested capacity, rounded up to a power of two (at least 2).
+         */
+        explicit ConcurrentRequestQueue(int capacity);
+
+        ConcurrentRequestQueue(const ConcurrentRequestQueue&) = delete;
+        ConcurrentRequestQueue& operator=(const ConcurrentRequestQueue&) = delete;
+
+        /**
+         * @brief Appends a request. Safe to call from any thread.
+         * @param request Request to enqueue.
+         * @return true if the request was queued, false if the queue was full.
+         */
+        bool tryPush(const Request& request);
+
+        /**
+         * @brief Removes the oldest request. Safe to call from any thread.
+         * @param out Receives the request when one is available.
+         * @return true if a request was removed, false if the queue was empty.
+         */
+        bool tryPop(Request& out);
+
+        /**
+         * @brief Returns the number of queued requests without synchronizing with producers or consumers.
+         *
+         * Wait-free; the value may lag concurrent pushes and pops.
+         *
+         * @return Approximate queue size.
+         */
+        int sizeApprox() const;
+
+        /**
+         * @brief Returns the number of requests the queue can hold.
+         * @return Capacity.
+         */
+        int capacity() const;
+};
+
+#endif
@@ -21,7 +21,56 @@ void Config::setDefault() {
     minProcessTime = 5;
     maxProcessTime = 20;
     newRequestProb = 0.25;
+    arrivalProcess = "bernoulli";
+    arrivalRate = 2.0;
+    burstRate = 20.0;
+    quietLength = 500;
+    burstLength = 50;
+    diurnalPeriod = 10000;
+    diurnalAmplitude = 0.5;
+    simulationMode = "tick";
+    workerThreads = 4;
+    shardEpoch = 1;
+    seed = 0;
+    dispatchPolicy = "first-idle";
+    localQueueSize = 0;
+    ingressQueueSize = 4096;
+    maxQueueDepth = 0;
+    queueMemoryBudget = 0;
+    shedPolicy = "drop-tail";
+    codelTarget = 20;
+    codelInterval = 200;
+    redMinFraction = 0.5;
+    spillHighWaterMark = 0;
+    spillDirectory = "/tmp";
+    spillSegmentSize = 65536;
+    autoscaler = "threshold";
+    requestGenerator = "xoshiro256";
+    targetUtilization = 0.8;
+    ewmaAlpha = 0.01;
+    drainHorizon = 500;
+    maxScaleStep = 4;
     blockedIpRanges.clear();
+    blocklistFile = "";
+    blocklistReloadInterval = 0;
+    rateLimit = 0;
+    rateLimitBurst = 10;
+    rateLimitSources = 65536;
+    topTalkers = 10;
+    autoBlockThreshold = 0;
+    autoBlockWindow = 100;
+    consoleMode = "events";
+    dashboardRefreshRate = 10;
+    logFormat = "text";
+    logCategories = "all";
+    logSampleRate = 1;
+    logMode = "sync";
+    logBufferSize = 65536;
+    logOverflow = "block";
+    metricsFile = "";
+    metricsInterval = 1;
+    metricsFormat = "binary";
+    sourceFile = "";
 }
 
 void Config::parseBlockedIpRanges(const std::string& rangesStr){
@@ -46,6 +95,127 @@ void Config::parseBlockedIpRanges(const std::string& rangesStr){
     }
 }
 
+bool Config::applySetting(const std::string& key, const std::string& value){
+    if (key == "initServers") {
+        initServers = std::stoi(value);
+    } else if (key == "totalRunTime") {
+        totalRunTime = std::stoi(value);
+    } else if (key == "minQueuePerServer") {
+        minQueuePerServer = std::stoi(value);
+    } else if (key == "maxQueuePerServer") {
+        maxQueuePerServer = std::stoi(value);
+    } else if (key == "scaleCooldownTime") {
+        scaleCooldownTime = std::stoi(value);
+    } else if (key == "minProcessTime") {
+        minProcessTime = std::stoi(value);
+    } else if (key == "maxProcessTime") {
+        maxProcessTime = std::stoi(value);
+    } else if (key == "newRequestProb") {
+        newRequestProb = std::stod(value);
+    } else if (key == "arrivalProcess") {
+        arrivalProcess = value;
+    } else if (key == "arrivalRate") {
+        arrivalRate = std::stod(value);
+    } else if (key == "burstRate") {
+        burstRate = std::stod(value);
+    } else if (key == "quietLength") {
+        quietLength = std::stoi(value);
+    } else if (key == "burstLength") {
+        burstLength = std::stoi(value);
+    } else if (key == "diurnalPeriod") {
+        diurnalPeriod = std::stoi(value);
+    } else if (key == "diurnalAmplitude") {
+        diurnalAmplitude = std::stod(value);
+    } else if (key == "simulationMode") {
+        simulationMode = value;
+    } else if (key == "workerThreads") {
+        workerThreads = std::stoi(value);
+    } else if (key == "shardEpoch") {
+        shardEpoch = std::stoi(value);
+    } else if (key == "seed") {
+        seed = std::stoul(value);
+    } else if (key == "dispatchPolicy") {
+        dispatchPolicy = value;
+    } else if (key == "localQueueSize") {
+        localQueueSize = std::stoi(value);
+    } else if (key == "ingressQueueSize") {
+        ingressQueueSize = std::stoi(value);
+    } else if (key == "maxQueueDepth") {
+        maxQueueDepth = std::stoi(value);
+    } else if (key == "queueMemoryBudget") {
+        queueMemoryBudget = std::stoll(value);
+    } else if (key == "shedPolicy") {
+        shedPolicy = value;
+    } else if (key == "codelTarget") {
+        codelTarget = std::stoi(value);
+    } else if (key == "codelInterval") {
+        codelInterval = std::stoi(value);
+    } else if (key == "redMinFraction") {
+        redMinFraction = std::stod(value);
+    } else if (key == "spillHighWaterMark") {
+        spillHighWaterMark = std::stoi(value);
+    } else if (key == "spillDirectory") {
+        spillDirectory = value;
+    } else if (key == "spillSegmentSize") {
+        spillSegmentSize = std::stoi(value);
+    } else if (key == "requestGenerator") {
+        requestGenerator = value;
+    } else if (key == "autoscaler") {
+        autoscaler = value;
+    } else if (key == "targetUtilization") {
+        targetUtilization = std::stod(value);
+    } else if (key == "ewmaAlpha") {
+        ewmaAlpha = std::stod(value);
+    } else if (key == "drainHorizon") {
+        drainHorizon = std::stoi(value);
+    } else if (key == "maxScaleStep") {
+        maxScaleStep = std::stoi(value);
+    } else if (key == "blockedIpRanges") {
+        parseBlockedIpRanges(value);
+    } else if (key == "blocklistFile") {
+        blocklistFile = value;
+    } else if (key == "rateLimit") {
+        rateLimit = std::stod(value);
+    } else if (key == "rateLimitBurst") {
+        rateLimitBurst = std::stod(value);
+    } else if (key == "rateLimitSources") {
+        rateLimitSources = std::stoi(value);
+    } else if (key == "topTalkers") {
+        topTalkers = std::stoi(value);
+    } else if (key == "autoBlockThreshold") {
+        autoBlockThreshold = std::stoi(value);
+    } else if (key == "autoBlockWindow") {
+        autoBlockWindow = std::stoi(value);
+    } else if (key == "blocklistReloadInterval") {
+        blocklistReloadInterval = std::stoi(value);
+    } else if (key == "consoleMode") {
+        consoleMode = value;
+    } else if (key == "dashboardRefreshRate") {
+        dashboardRefreshRate = std::stoi(value);
+    } else if (key == "logFormat") {
+        logFormat = value;
+    } else if (key == "logCategories") {
+        logCategories = value;
+    } else if (key == "logSampleRate") {
+        logSampleRate = std::stoi(value);
+    } else if (key == "logMode") {
+        logMode = value;
+    } else if (key == "logBufferSize") {
+        logBufferSize = std::stoi(value);
+    } else if (key == "logOverflow") {
+        logOverflow = value;
+    } else if (key == "metricsFile") {
+        metricsFile = value;
+    } else if (key == "metricsInterval") {
+        metricsInterval = std::stoi(value);
+    } else if (key == "metricsFormat") {
+        metricsFormat = value;
+    } else {
+        return false;
+    }
+    return true;
+}
+
 bool Config::loadFromFile(const std::string& filename){
     std::ifstream file(filename);
 
@@ -69,27 +239,10 @@ bool Config::loadFromFile(const std::string& filename){
         std::string key = line.substr(0, equal_pos);
         std::string value = line.substr(equal_pos + 1);
 
-        if (key == "initServers") {
-            initServers = std::stoi(value);
-        } else if (key == "totalRunTime") {
-            totalRunTime = std::stoi(value);
-        } else if (key == "minQueuePerServer") {
-            minQueuePerServer = std::stoi(value);
-        } else if (key == "maxQueuePerServer") {
-            maxQueuePerServer = std::stoi(value);
-        } else if (key == "scaleCooldownTime") {
-            scaleCooldownTime = std::stoi(value);
-        } else if (key == "minProcessTime") {
-            minProcessTime = std::stoi(value);
-        } else if (key == "maxProcessTime") {
-            maxProcessTime = std::stoi(value);
-        } else if (key == "newRequestProb") {
-            newRequestProb = std::stod(value);
-        } else if (key == "blockedIpRanges") {
-            parseBlockedIpRanges(value);
-        }
+        applySetting(key, value);
     }
     file.close();
+    sourceFile = filename;
     return true;
 }
 
@@ -125,10 +278,206 @@ double Config::getNewRequestProb() const {
     return newRequestProb;
 }
 
+const std::string& Config::getArrivalProcess() const {
+    return arrivalProcess;
+}
+
+double Config::getArrivalRate() const {
+    return arrivalRate;
+}
+
+double Config::getBurstRate() const {
+    return burstRate;
+}
+
+int Config::getQuietLength() const {
+    return quietLength;
+}
+
+int Config::getBurstLength() const {
+    return burstLength;
+}
+
+int Config::getDiurnalPeriod() const {
+    return diurnalPeriod;
+}
+
+double Config::getDiurnalAmplitude() const {
+    return diurnalAmplitude;
+}
+
+const std::string& Config::getSimulationMode() const {
+    return simulationMode;
+}
+
+int Config::getWorkerThreads() const {
+    return workerThreads;
+}
+
+int Config::getShardEpoch() const {
+    return shardEpoch;
+}
+
+unsigned int Config::getSeed() const {
+    return seed;
+}
+
+const std::string& Config::getDispatchPolicy() const {
+    return dispatchPolicy;
+}
+
+int Config::getLocalQueueSize() const {
+    return localQueueSize;
+}
+
+int Config::getIngressQueueSize() const {
+    return ingressQueueSize;
+}
+
+int Config::getMaxQueueDepth() const {
+    return maxQueueDepth;
+}
+
+long long Config::getQueueMemoryBudget() const {
+    return queueMemoryBudget;
+}
+
+const std::string& Config::getShedPolicy() const {
+    return shedPolicy;
+}
+
+int Config::getCodelTarget() const {
+    return codelTarget;
+}
+
+int Config::getCodelInterval() const {
+    return codelInterval;
+}
+
+double Config::getRedMinFraction() const {
+    return redMinFraction;
+}
+
+int Config::getSpillHighWaterMark() const {
+    return spillHighWaterMark;
+}
+
+const std::string& Config::getSpillDirectory() const {
+    return spillDirectory;
+}
+
+int Config::getSpillSegmentSize() const {
+    return spillSegmentSize;
+}
+
+const std::string& Config::getRequestGenerator() const {
+    return requestGenerator;
+}
+
+const std::string& Config::getAutoscaler() const {
+    return autoscaler;
+}
+
+double Config::getTargetUtilization() const {
+    return targetUtilization;
+}
+
+double Config::getEwmaAlpha() const {
+    return ewmaAlpha;
+}
+
+int Config::getDrainHorizon() const {
+    return drainHorizon;
+}
+
+int Config::getMaxScaleStep() const {
+    return maxScaleStep;
+}
+
 const std::vector<IpRange>& Config::getBlockedIpRanges() const {
     return blockedIpRanges;
 }
 
+const std::string& Config::getBlocklistFile() const {
+    return blocklistFile;
+}
+
+double Config::getRateLimit() const {
+    return rateLimit;
+}
+
+double Config::getRateLimitBurst() const {
+    return rateLimitBurst;
+}
+
+int Config::getRateLimitSources() const {
+    return rateLimitSources;
+}
+
+int Config::getTopTalkers() const {
+    return topTalkers;
+}
+
+int Config::getAutoBlockThreshold() const {
+    return autoBlockThreshold;
+}
+
+int Config::getAutoBlockWindow() const {
+    return autoBlockWindow;
+}
+
+int Config::getBlocklistReloadInterval() const {
+    return blocklistReloadInterval;
+}
+
+const std::string& Config::getConsoleMode() const {
+    return consoleMode;
+}
+
+int Config::getDashboardRefreshRate() const {
+    return dashboardRefreshRate;
+}
+
+const std::string& Config::getLogFormat() const {
+    return logFormat;
+}
+
+const std::string& Config::getLogCategories() const {
+    return logCategories;
+}
+
+int Config::getLogSampleRate() const {
+    return logSampleRate;
+}
+
+const std::string& Config::getLogMode() const {
+    return logMode;
+}
+
+int Config::getLogBufferSize() const {
+    return logBufferSize;
+}
+
+const std::string& Config::getLogOverflow() const {
+    return logOverflow;
+}
+
+const std::string& Config::getMetricsFile() const {
+    return metricsFile;
+}
+
+int Config::getMetricsInterval() const {
+    return metricsInterval;
+}
+
+const std::string& Config::getMetricsFormat() const {
+    return metricsFormat;
+}
+
+const std::string& Config::getSourceFile() const {
+    return sourceFile;
+}
+
 void Config::setInitServers(int count) {
     initServers = count;
 }
@@ -147,11 +496,59 @@ void Config::printConfig() const {
     std::cout << "minProcessTime:                  " << minProcessTime << std::endl;
     std::cout << "maxProcessTime:                  " << maxProcessTime << std::endl;
     std::cout << "newRequestProb:                  " << newRequestProb << std::endl;
+    std::cout << "arrivalProcess:                  " << arrivalProcess << std::endl;
+    std::cout << "arrivalRate:                     " << arrivalRate << std::endl;
+    std::cout << "burstRate:                       " << burstRate << std::endl;
+    std::cout << "quietLength:                     " << quietLength << std::endl;
+    std::cout << "burstLength:                     " << burstLength << std::endl;
+    std::cout << "diurnalPeriod:                   " << diurnalPeriod << std::endl;
+    std::cout << "diurnalAmplitude:                " << diurnalAmplitude << std::endl;
+    std::cout << "simulationMode:                  " << simulationMode << std::endl;
+    std::cout << "workerThreads:                   " << workerThreads << std::endl;
+    std::cout << "shardEpoch:                      " << shardEpoch << std::endl;
+    std::cout << "seed:                            " << seed << std::endl;
+    std::cout << "dispatchPolicy:                  " << dispatchPolicy << std::endl;
+    std::cout << "localQueueSize:                  " << localQueueSize << std::endl;
+    std::cout << "ingressQueueSize:                " << ingressQueueSize << std::endl;
+    std::cout << "maxQueueDepth:                   " << maxQueueDepth << std::endl;
+    std::cout << "queueMemoryBudget:               " << queueMemoryBudget << std::endl;
+    std::cout << "shedPolicy:                      " << shedPolicy << std::endl;
+    std::cout << "codelTarget:                     " << codelTarget << std::endl;
+    std::cout << "codelInterval:                   " << codelInterval << std::endl;
+    std::cout << "redMinFraction:                  " << redMinFraction << std::endl;
+    std::cout << "spillHighWaterMark:              " << spillHighWaterMark << std::endl;
+    std::cout << "spillDirectory:                  " << spillDirectory << std::endl;
+    std::cout << "spillSegmentSize:                " << spillSegmentSize << std::endl;
+    std::cout << "requestGenerator:                " << requestGenerator << std::endl;
+    std::cout << "autoscaler:                      " << autoscaler << std::endl;
+    std::cout << "targetUtilization:               " << targetUtilization << std::endl;
+    std::cout << "ewmaAlpha:                       " << ewmaAlpha << std::endl;
+    std::cout << "drainHorizon:                    " << drainHorizon << std::endl;
+    std::cout << "maxScaleStep:                    " << maxScaleStep << std::endl;
 
     std::cout << "blockedIpRanges: ";
     for (const auto& range : blockedIpRanges) {
         std::cout << range.getStartIp() << "-" << range.getEndIp() << ", ";
     }
     std::cout << std::endl;
+    std::cout << "blocklistFile:                   " << blocklistFile << std::endl;
+    std::cout << "blocklistReloadInterval:         " << blocklistReloadInterval << std::endl;
+    std::cout << "rateLimit:                       " << rateLimit << std::endl;
+    std::cout << "rateLimitBurst:                  " << rateLimitBurst << std::endl;
+    std::cout << "rateLimitSources:                " << rateLimitSources << std::endl;
+    std::cout << "topTalkers:                      " << topTalkers << std::endl;
+    std::cout << "autoBlockThreshold:              " << autoBlockThreshold << std::endl;
+    std::cout << "autoBlockWindow:                 " << autoBlockWindow << std::endl;
+    std::cout << "consoleMode:                     " << consoleMode << std::endl;
+    std::cout << "dashboardRefreshRate:            " << dashboardRefreshRate << std::endl;
+    std::cout << "logFormat:                       " << logFormat << std::endl;
+    std::cout << "logCategories:                   " << logCategories << std::endl;
+    std::cout << "logSampleRate:                   " << logSampleRate << std::endl;
+    std::cout << "logMode:                         " << logMode << std::endl;
+    std::cout << "logBufferSize:                   " << logBufferSize << std::endl;
+    std::cout << "logOverflow:                     " << logOverflow << std::endl;
+    std::cout << "metricsFile:                     " << metricsFile << std::endl;
+    std::cout << "metricsInterval:                 " << metricsInterval << std::endl;
+    std::cout << "metricsFormat:                   " << metricsFormat << std::endl;
     std::cout << "================================="<< std::endl;
 }
\ No newline at end of file
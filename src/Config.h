@@ -28,8 +28,57 @@ class Config{
         int scaleCooldownTime;        ///< Minimum clock cycles between consecutive scaling events
         int minProcessTime;           ///< Minimum processing time for a generated request (cycles)
         int maxProcessTime;           ///< Maximum processing time for a generated request (cycles)
-        double newRequestProb;        ///< Probability [0,1] of a new request arriving each cycle
+        double newRequestProb;        ///< Probability [0,1] of a new request arriving each cycle (bernoulli arrivals)
+        std::string arrivalProcess;   ///< Name of the ArrivalProcess model
+        double arrivalRate;           ///< Mean arrivals per cycle (poisson, mmpp quiet state, diurnal average)
+        double burstRate;             ///< Mean arrivals per cycle in the mmpp burst state
+        int quietLength;              ///< Mean length in cycles of an mmpp quiet period
+        int burstLength;              ///< Mean length in cycles of an mmpp burst
+        int diurnalPeriod;            ///< Cycles per diurnal rate cycle
+        double diurnalAmplitude;      ///< Relative swing of the diurnal rate, in [0, 1]
+        std::string simulationMode;   ///< "tick", "event" (jump between events) or "parallel" (sharded across threads)
+        int workerThreads;            ///< Number of shards/worker threads in parallel mode
+        int shardEpoch;               ///< Clock cycles each shard runs between synchronization barriers
+        unsigned int seed;            ///< Random seed for request generation (0 = nondeterministic)
+        std::string dispatchPolicy;   ///< Name of the DispatchPolicy used to pick servers
+        int localQueueSize;           ///< Capacity of each server's local request queue
+        int ingressQueueSize;         ///< Capacity of the lock-free queue behind LoadBalancer::submit()
+        int maxQueueDepth;            ///< Most requests the central queue may hold (0 = unbounded)
+        long long queueMemoryBudget;  ///< Most bytes of requests the central queue may hold (0 = unbounded)
+        std::string shedPolicy;       ///< Name of the ShedPolicy applying the queue limits
+        int codelTarget;              ///< Queue wait in cycles the codel policy tolerates
+        int codelInterval;            ///< Cycles the wait must exceed codelTarget before codel sheds
+        double redMinFraction;        ///< Fraction of the depth limit at which the red policy starts shedding
+        int spillHighWaterMark;       ///< Queued requests kept in memory before the rest spill to disk (0 = never spill)
+        std::string spillDirectory;   ///< Directory for the spill segment files
+        int spillSegmentSize;         ///< Requests per spill segment file
+        std::string autoscaler;       ///< Name of the Autoscaler that sizes the pool
+        std::string requestGenerator; ///< Name of the RequestGenerator engine
+        double targetUtilization;     ///< Busy fraction the predictive autoscaler aims for
+        double ewmaAlpha;             ///< Smoothing weight of the predictive autoscaler's rate estimates
+        int drainHorizon;             ///< Cycles within which the predictive autoscaler aims to clear the backlog
+        int maxScaleStep;             ///< Most servers the predictive autoscaler adds or removes at once
         std::vector<IpRange> blockedIpRanges;  ///< IP ranges whose requests will be rejected
+        std::string blocklistFile;    ///< File of blocked CIDR prefixes, one per line (empty = none)
+        double rateLimit;             ///< Requests per cycle each source IP may sustain (0 = unlimited)
+        double rateLimitBurst;        ///< Requests a source IP may send at once before its rate applies
+        int rateLimitSources;         ///< Most source IPs the rate limiter tracks at once
+        int topTalkers;               ///< Heaviest source IPs reported in the status lines and summary (0 = none)
+        int autoBlockThreshold;       ///< Requests within autoBlockWindow that get a source IP blocked (0 = never)
+        int autoBlockWindow;          ///< Cycles over which autoBlockThreshold is counted
+        int blocklistReloadInterval;  ///< Milliseconds between checks for blocklist edits (0 = never reload)
+        std::string consoleMode;      ///< "events" to echo every log line, "dashboard" for a live summary screen, "off" for neither
+        int dashboardRefreshRate;     ///< Most dashboard redraws per second
+        std::string logFormat;        ///< "text" for log.txt, "binary" for the compact log.bin read back with logdecode
+        std::string logCategories;    ///< Comma-separated LogCategory names written to the log, or "all"
+        int logSampleRate;            ///< Per-request log entries are kept 1 in logSampleRate
+        std::string logMode;          ///< "sync" to write each log line as it happens, "async" to hand lines to a writer thread
+        int logBufferSize;            ///< Records the async log buffer holds before logOverflow applies
+        std::string logOverflow;      ///< What a full async log buffer does: "block" the simulation or "drop" the record
+        std::string metricsFile;      ///< File receiving the per-cycle metrics columns (empty = not recorded)
+        int metricsInterval;          ///< Cycles covered by each metrics row
+        std::string metricsFormat;    ///< "binary" for the mmap-able columnar file, "csv" for one row per line
+        std::string sourceFile;       ///< Config file last loaded successfully (empty = defaults only)
 
         /**
          * @brief Parses a comma-separated list of "startIp-endIp" range strings.
@@ -59,6 +108,15 @@ class Config{
          */
         bool loadFromFile(const std::string& filename);
 
+        /**
+         * @brief Sets one parameter from its config file key and text value.
+         * @param key Parameter name as written in config.txt.
+         * @param value Parameter value as written in config.txt.
+         * @return true if the key is recognized, false otherwise.
+         * @throws std::invalid_argument or std::out_of_range if a numeric value does not parse.
+         */
+        bool applySetting(const std::string& key, const std::string& value);
+
         /** @brief Returns the initial number of servers. */
         int getInitServers() const;
 
@@ -83,12 +141,159 @@ class Config{
         /** @brief Returns the per-cycle probability of a new request arriving. */
         double getNewRequestProb() const;
 
+        /** @brief Returns the arrival model name (see ArrivalProcess::create()). */
+        const std::string& getArrivalProcess() const;
+
+        /** @brief Returns the mean arrivals per cycle for the poisson, mmpp and diurnal models. */
+        double getArrivalRate() const;
+
+        /** @brief Returns the mean arrivals per cycle during an mmpp burst. */
+        double getBurstRate() const;
+
+        /** @brief Returns the mean length in cycles of an mmpp quiet period. */
+        int getQuietLength() const;
+
+        /** @brief Returns the mean length in cycles of an mmpp burst. */
+        int getBurstLength() const;
+
+        /** @brief Returns the period in cycles of the diurnal model. */
+        int getDiurnalPeriod() const;
+
+        /** @brief Returns the relative amplitude of the diurnal model. */
+        double getDiurnalAmplitude() const;
+
+        /** @brief Returns the simulation mode ("tick", "event" or "parallel"). */
+        const std::string& getSimulationMode() const;
+
+        /** @brief Returns the number of worker threads used in parallel mode. */
+        int getWorkerThreads() const;
+
+        /** @brief Returns the number of clock cycles between shard barriers in parallel mode. */
+        int getShardEpoch() const;
+
+        /** @brief Returns the random seed (0 means seed from std::random_device). */
+        unsigned int getSeed() const;
+
+        /** @brief Returns the dispatch policy name (see DispatchPolicy::create()). */
+        const std::string& getDispatchPolicy() const;
+
+        /** @brief Returns the capacity of each server's local request queue. */
+        int getLocalQueueSize() const;
+
+        /** @brief Returns the capacity of the queue for requests submitted from other threads. */
+        int getIngressQueueSize() const;
+
+        /** @brief Returns the central queue depth limit (0 = unbounded). */
+        int getMaxQueueDepth() const;
+
+        /** @brief Returns the central queue memory budget in bytes (0 = unbounded). */
+        long long getQueueMemoryBudget() const;
+
+        /** @brief Returns the shed policy name (see ShedPolicy::create()). */
+        const std::string& getShedPolicy() const;
+
+        /** @brief Returns the queue wait in cycles the codel policy tolerates. */
+        int getCodelTarget() const;
+
+        /** @brief Returns the cycles the wait must exceed the target before codel sheds. */
+        int getCodelInterval() const;
+
+        /** @brief Returns the fraction of the depth limit at which red starts shedding. */
+        double getRedMinFraction() const;
+
+        /** @brief Returns the in-memory queue length above which requests spill to disk (0 = never). */
+        int getSpillHighWaterMark() const;
+
+        /** @brief Returns the directory for the spill segment files. */
+        const std::string& getSpillDirectory() const;
+
+        /** @brief Returns the number of requests per spill segment file. */
+        int getSpillSegmentSize() const;
+
+        /** @brief Returns the request generator name (see RequestGenerator::create()). */
+        const std::string& getRequestGenerator() const;
+
+        /** @brief Returns the autoscaler name (see Autoscaler::create()). */
+        const std::string& getAutoscaler() const;
+
+        /** @brief Returns the target server utilization for the predictive autoscaler. */
+        double getTargetUtilization() const;
+
+        /** @brief Returns the EWMA smoothing weight for the predictive autoscaler. */
+        double getEwmaAlpha() const;
+
+        /** @brief Returns the backlog drain horizon in cycles for the predictive autoscaler. */
+        int getDrainHorizon() const;
+
+        /** @brief Returns the largest change in server count per predictive scaling step. */
+        int getMaxScaleStep() const;
+
         /**
          * @brief Returns a read-only reference to the list of blocked IP ranges.
          * @return Const reference to the blocked IP range vector.
          */
         const std::vector<IpRange>& getBlockedIpRanges() const;
 
+        /** @brief Returns the path of the CIDR prefix blocklist file, or an empty string. */
+        const std::string& getBlocklistFile() const;
+
+        /** @brief Returns the requests per cycle each source IP may sustain, or 0 for no rate limit. */
+        double getRateLimit() const;
+
+        /** @brief Returns the token bucket capacity of each source IP. */
+        double getRateLimitBurst() const;
+
+        /** @brief Returns the most source IPs the rate limiter tracks at once. */
+        int getRateLimitSources() const;
+
+        /** @brief Returns the number of heaviest source IPs to report, or 0 for none. */
+        int getTopTalkers() const;
+
+        /** @brief Returns the requests per window that get a source IP blocked, or 0 if auto-blocking is off. */
+        int getAutoBlockThreshold() const;
+
+        /** @brief Returns the length in cycles of the auto-block counting window. */
+        int getAutoBlockWindow() const;
+
+        /** @brief Returns the milliseconds between checks for blocklist edits, or 0 if the blocklist is fixed. */
+        int getBlocklistReloadInterval() const;
+
+        /** @brief Returns the console mode, "events", "dashboard" or "off". */
+        const std::string& getConsoleMode() const;
+
+        /** @brief Returns the most dashboard redraws per second. */
+        int getDashboardRefreshRate() const;
+
+        /** @brief Returns the log file format, "text" or "binary". */
+        const std::string& getLogFormat() const;
+
+        /** @brief Returns the categories of log entries to write (see LogFile::parseCategories()). */
+        const std::string& getLogCategories() const;
+
+        /** @brief Returns N such that 1 in N per-request log entries is kept. */
+        int getLogSampleRate() const;
+
+        /** @brief Returns the logging mode, "sync" or "async". */
+        const std::string& getLogMode() const;
+
+        /** @brief Returns the number of records the async log buffer holds. */
+        int getLogBufferSize() const;
+
+        /** @brief Returns what a full async log buffer does, "block" or "drop". */
+        const std::string& getLogOverflow() const;
+
+        /** @brief Returns the file receiving the metrics columns, or an empty string if they are not recorded. */
+        const std::string& getMetricsFile() const;
+
+        /** @brief Returns the number of cycles covered by each metrics row. */
+        int getMetricsInterval() const;
+
+        /** @brief Returns the metrics file format, "binary" or "csv". */
+        const std::string& getMetricsFormat() const;
+
+        /** @brief Returns the config file last loaded successfully, or an empty string. */
+        const std::string& getSourceFile() const;
+
         /**
          * @brief Overrides the initial server count (e.g., from user input).
          * @param count New initial server count.
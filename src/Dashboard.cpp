@@ -0,0 +1,138 @@
+/**
+ * @file Dashboard.cpp
+ * @brief Implementation of the Dashboard class.
+ */
+
+#include "Dashboard.h"
+#include "LogFile.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+namespace {
+
+/// Sparkline glyphs from lowest to highest.
+const char* const sparkGlyphs[] = {"▁", "▂", "▃", "▄", "▅", "▆", "▇", "█"};
+
+/// Appends one frame line, clearing whatever the previous frame left to its right.
+void appendLine(std::string& frame, const std::string& line) {
+    frame += line;
+    frame += "\033[K\n";
+}
+
+/// Formats a value with a fixed number of decimals.
+std::string fixed(double value, int decimals) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.*f", decimals, value);
+    return text;
+}
+
+}
+
+Dashboard::Dashboard(int refreshRate, int totalRunTime)
+    : refreshInterval(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(1.0 / std::max(refreshRate, 1)))),
+      totalRunTime(std::max(totalRunTime, 1)), updatesUntilClock(0), started(false), drawn(false), finished(false),
+      cycle(0), queueDepth(0), servers(0), processed(0), blocked(0), rejected(0), peakDepth(0),
+      lastCycle(0), lastProcessed(0), lastBlocked(0), lastRejected(0) {
+}
+
+void Dashboard::update(int cycle, int queueDepth, int servers, long long processed, long long blocked, long long rejected) {
+    if (finished) {
+        return;
+    }
+    this->cycle = cycle;
+    this->queueDepth = queueDepth;
+    this->servers = servers;
+    this->processed = processed;
+    this->blocked = blocked;
+    this->rejected = rejected;
+    peakDepth = std::max(peakDepth, queueDepth);
+
+    if (--updatesUntilClock > 0) {
+        return;
+    }
+    updatesUntilClock = clockStride;
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (!started) {
+        started = true;
+        startTime = now;
+        lastDrawTime = now;
+        draw(now);
+    } else if (now - lastDrawTime >= refreshInterval) {
+        draw(now);
+    }
+}
+
+void Dashboard::finish() {
+    if (finished) {
+        return;
+    }
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (!started) {
+        startTime = now;
+        lastDrawTime = now;
+    }
+    draw(now);
+    finished = true;
+}
+
+void Dashboard::draw(std::chrono::steady_clock::time_point now) {
+    double seconds = std::chrono::duration<double>(now - lastDrawTime).count();
+    double elapsed = std::chrono::duration<double>(now - startTime).count();
+    double perSecond = seconds > 0 ? 1.0 / seconds : 0.0;
+
+    long long newProcessed = processed - lastProcessed;
+    long long newBlocked = blocked - lastBlocked;
+    long long newRejected = rejected - lastRejected;
+    long long finishedRequests = newProcessed + newBlocked + newRejected;
+    double blockedShare = finishedRequests > 0 ? 100.0 * newBlocked / finishedRequests : 0.0;
+
+    depthHistory.push_back(peakDepth);
+    if (static_cast<int>(depthHistory.size()) > sparkWidth) {
+        depthHistory.erase(depthHistory.begin());
+    }
+    int historyPeak = *std::max_element(depthHistory.begin(), depthHistory.end());
+
+    const int barWidth = 40;
+    int done = std::min(barWidth, static_cast<int>(static_cast<long long>(cycle + 1) * barWidth / totalRunTime));
+    std::string bar = std::string(done, '#') + std::string(barWidth - done, '-');
+
+    std::string spark;
+    for (int depth : depthHistory) {
+        int level = historyPeak > 0 ? static_cast<int>(static_cast<long long>(depth) * 7 / historyPeak) : 0;
+        spark += sparkGlyphs[level];
+    }
+
+    frame.clear();
+    if (drawn) {
+        // cursor to the first line of the previous frame
+        frame += "\033[" + std::to_string(frameLines) + "F";
+    }
+    appendLine(frame, std::string(BOLD) + BLUE + "LOAD BALANCER" + RESET + "  [" + bar + "] " +
+                      fixed(100.0 * std::min(cycle + 1, totalRunTime) / totalRunTime, 1) + "%");
+    appendLine(frame, "  Cycle:         " + std::to_string(cycle) + " / " + std::to_string(totalRunTime) +
+                      "   (" + fixed((cycle - lastCycle) * perSecond, 0) + " cycles/s, " + fixed(elapsed, 1) + " s)");
+    appendLine(frame, "  Queue Depth:   " + std::string(YELLOW) + std::to_string(queueDepth) + RESET);
+    appendLine(frame, "  Servers:       " + std::string(GREEN) + std::to_string(servers) + RESET);
+    appendLine(frame, "  Throughput:    " + std::string(CYAN) + fixed(newProcessed * perSecond, 0) + " req/s" + RESET +
+                      "   (" + std::to_string(processed) + " processed)");
+    appendLine(frame, "  Blocked:       " + std::string(RED) + fixed(newBlocked * perSecond, 0) + " req/s" + RESET +
+                      "   (" + fixed(blockedShare, 1) + "% of requests, " + std::to_string(blocked) + " total)");
+    appendLine(frame, "  Shed/Limited:  " + std::string(MAGENTA) + fixed(newRejected * perSecond, 0) + " req/s" + RESET +
+                      "   (" + std::to_string(rejected) + " total)");
+    appendLine(frame, "");
+    appendLine(frame, "  Queue depth, peak per refresh (max " + std::to_string(historyPeak) + "):");
+    appendLine(frame, "  " + spark);
+
+    std::cout.write(frame.data(), frame.size());
+    std::cout.flush();
+
+    drawn = true;
+    lastDrawTime = now;
+    lastCycle = cycle;
+    lastProcessed = processed;
+    lastBlocked = blocked;
+    lastRejected = rejected;
+    peakDepth = queueDepth;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file Dashboard.h
+ * @brief Declaration of the Dashboard class, a live console view of a running simulation.
+ */
+
+#ifndef DASHBOARD_H
+#define DASHBOARD_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * @class Dashboard
+ * @brief Fixed-size ANSI console screen redrawn at a capped rate.
+ *
+ * The simulation reports its state every cycle through update(), which
+ * only stores it; the wall clock is read every clockStride updates and the
+ * screen redrawn once refreshInterval has passed, so a fast run costs a few
+ * stores per cycle and at most refreshRate small writes per second. Each
+ * redraw moves the cursor back to the top of the previous frame and
+ * overwrites it, leaving whatever was printed before the run in place.
+ *
+ * The frame shows the cycle and progress, queue depth, server count,
+ * throughput and blocked rate over the last interval, and a sparkline of
+ * the largest queue depth seen in each of the last sparkWidth intervals.
+ */
+class Dashboard {
+    private:
+        static const int sparkWidth = 60;      ///< Intervals shown by the sparkline
+        static const int clockStride = 64;     ///< Updates between reads of the wall clock
+        static const int frameLines = 10;      ///< Lines in every frame
+
+        std::chrono::steady_clock::duration refreshInterval;   ///< Least time between redraws
+        std::chrono::steady_clock::time_point startTime;       ///< When the first update arrived
+        std::chrono::steady_clock::time_point lastDrawTime;    ///< When the last frame was drawn
+        int totalRunTime;               ///< Cycles the run will take, for the progress bar
+        int updatesUntilClock;          ///< Updates left before the clock is read again
+        bool started;                   ///< Whether an update has arrived
+        bool drawn;                     ///< Whether a frame is on screen
+        bool finished;                  ///< Whether finish() has drawn the last frame
+
+        int cycle;                      ///< Latest cycle
+        int queueDepth;                 ///< Latest queue depth
+        int servers;                    ///< Latest server count
+        long long processed;            ///< Requests completed so far
+        long long blocked;              ///< Requests blocked so far
+        long long rejected;             ///< Requests shed or rate limited so far
+        int peakDepth;                  ///< Largest queue depth since the last redraw
+
+        int lastCycle;                  ///< Cycle at the last redraw
+        long long lastProcessed;        ///< Completions at the last redraw
+        long long lastBlocked;          ///< Blocks at the last redraw
+        long long lastRejected;         ///< Sheds and rate limits at the last redraw
+        std::vector<int> depthHistory;  ///< Peak queue depth of each recent interval, oldest first
+        std::string frame;              ///< Scratch space for one frame
+
+        /**
+         * @brief Draws a frame from the stored state and starts a new interval.
+         * @param now Current time.
+         */
+        void draw(std::chrono::steady_clock::time_point now);
+
+    public:
+        /**
+         * @brief Creates a dashboard; nothing is drawn until the first update.
+         * @param refreshRate Most redraws per second (at least 1).
+         * @param totalRunTime Cycles the run will take.
+         */
+        Dashboard(int refreshRate, int totalRunTime);
+
+        /**
+         * @brief Records the simulation state, redrawing if the refresh interval has passed.
+         * @param cycle Current clock cycle.
+         * @param queueDepth Requests waiting to start.
+         * @param servers Active servers.
+         * @param processed Requests completed so far.
+         * @param blocked Requests blocked so far.
+         * @param rejected Requests shed or rate limited so far.
+         */
+        void update(int cycle, int queueDepth, int servers, long long processed, long long blocked, long long rejected);
+
+        /** @brief Draws the final frame and stops redrawing; later calls do nothing. */
+        void finish();
+};
+
+#endif
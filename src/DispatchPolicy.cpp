@@ -0,0 +1,129 @@
+/**
+ * @file DispatchPolicy.cpp
+ * @brief Implementation of the built-in dispatch policies.
+ */
+
+#include "DispatchPolicy.h"
+
+DispatchPolicy::~DispatchPolicy() {
+}
+
+bool DispatchPolicy::needsLoadTracking() const {
+    return false;
+}
+
+bool DispatchPolicy::prefersIdle() const {
+    return false;
+}
+
+std::unique_ptr<DispatchPolicy> DispatchPolicy::create(const std::string& name, unsigned int seed) {
+    if (name == "first-idle") {
+        return std::unique_ptr<DispatchPolicy>(new FirstIdlePolicy());
+    } else if (name == "round-robin") {
+        return std::unique_ptr<DispatchPolicy>(new RoundRobinPolicy());
+    } else if (name == "least-remaining-time") {
+        return std::unique_ptr<DispatchPolicy>(new LeastRemainingTimePolicy());
+    } else if (name == "power-of-two") {
+        return std::unique_ptr<DispatchPolicy>(new PowerOfTwoPolicy(seed));
+    } else if (name == "join-idle-queue") {
+        return std::unique_ptr<DispatchPolicy>(new JoinIdleQueuePolicy(seed));
+    }
+    return nullptr;
+}
+
+int FirstIdlePolicy::pickServer(const ServerPool& pool) {
+    return pool.peekIdle();
+}
+
+bool FirstIdlePolicy::prefersIdle() const {
+    return true;
+}
+
+std::string FirstIdlePolicy::getName() const {
+    return "first-idle";
+}
+
+RoundRobinPolicy::RoundRobinPolicy() : cursor(0) {
+}
+
+int RoundRobinPolicy::pickServer(const ServerPool& pool) {
+    int n = pool.size();
+    if (n == 0) {
+        return -1;
+    }
+    // full slots are skipped rather than ending dispatch; one lap with no room means every server is full
+    for (int i = 0; i < n; i++) {
+        if (cursor >= n) {
+            cursor = 0;
+        }
+        int slot = cursor++;
+        if (pool.hasRoom(slot)) {
+            return slot;
+        }
+    }
+    return -1;
+}
+
+std::string RoundRobinPolicy::getName() const {
+    return "round-robin";
+}
+
+int LeastRemainingTimePolicy::pickServer(const ServerPool& pool) {
+    int slot = pool.leastLoaded();
+    if (slot < 0 || !pool.hasRoom(slot)) {
+        return pool.peekIdle();
+    }
+    return slot;
+}
+
+std::string LeastRemainingTimePolicy::getName() const {
+    return "least-remaining-time";
+}
+
+bool LeastRemainingTimePolicy::needsLoadTracking() const {
+    return true;
+}
+
+PowerOfTwoPolicy::PowerOfTwoPolicy(unsigned int seed) : rng(seed) {
+}
+
+int PowerOfTwoPolicy::pickServer(const ServerPool& pool) {
+    int n = pool.size();
+    if (n == 0) {
+        return -1;
+    }
+    std::uniform_int_distribution<int> dis(0, n - 1);
+    int a = dis(rng);
+    int b = dis(rng);
+    int slot = pool.getOutstanding(b) < pool.getOutstanding(a) ? b : a;
+    return pool.hasRoom(slot) ? slot : pool.peekIdle();
+}
+
+std::string PowerOfTwoPolicy::getName() const {
+    return "power-of-two";
+}
+
+JoinIdleQueuePolicy::JoinIdleQueuePolicy(unsigned int seed) : rng(seed) {
+}
+
+int JoinIdleQueuePolicy::pickServer(const ServerPool& pool) {
+    int slot = pool.peekIdle();
+    if (slot >= 0) {
+        return slot;
+    }
+    int n = pool.size();
+    if (n == 0) {
+        return -1;
+    }
+    std::uniform_int_distribution<int> dis(0, n - 1);
+    slot = dis(rng);
+    return pool.hasRoom(slot) ? slot : -1;
+}
+
+bool JoinIdleQueuePolicy::prefersIdle() const {
+    return true;
+}
+
+std::string JoinIdleQueuePolicy::getName() const {
+    return "join-idle-queue";
+}
@@ -0,0 +1,132 @@
+/**
+ * @file DispatchPolicy.h
+ * @brief Declaration of the DispatchPolicy interface and the built-in dispatch policies.
+ */
+
+#ifndef DISPATCHPOLICY_H
+#define DISPATCHPOLICY_H
+
+#include <memory>
+#include <random>
+#include <string>
+#include "ServerPool.h"
+
+/**
+ * @class DispatchPolicy
+ * @brief Chooses which server receives the request at the head of the queue.
+ *
+ * A policy returns a slot that has room (an idle server, or a busy server
+ * whose local queue is not full), or -1 to leave the remaining requests in the
+ * global queue until the next dispatch. A policy whose preferred server is
+ * full falls back to any idle server, so work is never held back while a
+ * server sits idle. Every built-in policy runs in O(1) or O(log n) per pick.
+ */
+class DispatchPolicy {
+    public:
+        virtual ~DispatchPolicy();
+
+        /**
+         * @brief Picks the server for the next request.
+         * @param pool Server pool to choose from.
+         * @return Slot with room for one more request, or -1 if none is chosen.
+         */
+        virtual int pickServer(const ServerPool& pool) = 0;
+
+        /** @brief Returns the policy name as written in config.txt. */
+        virtual std::string getName() const = 0;
+
+        /**
+         * @brief Returns true if the policy needs ServerPool load tracking (leastLoaded()).
+         */
+        virtual bool needsLoadTracking() const;
+
+        /**
+         * @brief Returns true if the policy picks peekIdle() whenever a server is idle.
+         *
+         * Such a policy lets the LoadBalancer start a batch of requests on
+         * the idle servers with one ServerPool::assignIdle() call before
+         * falling back to pickServer() for the rest.
+         */
+        virtual bool prefersIdle() const;
+
+        /**
+         * @brief Creates a policy by name.
+         *
+         * Known names: first-idle, round-robin, least-remaining-time,
+         * power-of-two, join-idle-queue.
+         *
+         * @param name Policy name.
+         * @param seed Seed for policies that make random choices.
+         * @return The new policy, or nullptr if the name is unknown.
+         */
+        static std::unique_ptr<DispatchPolicy> create(const std::string& name, unsigned int seed);
+};
+
+/**
+ * @class FirstIdlePolicy
+ * @brief Sends the request to any idle server; never uses local queues.
+ *
+ * This is the original behaviour of the load balancer.
+ */
+class FirstIdlePolicy : public DispatchPolicy {
+    public:
+        int pickServer(const ServerPool& pool) override;
+        bool prefersIdle() const override;
+        std::string getName() const override;
+};
+
+/**
+ * @class RoundRobinPolicy
+ * @brief Cycles through the slots in order, skipping slots with no room.
+ */
+class RoundRobinPolicy : public DispatchPolicy {
+    private:
+        int cursor;   ///< Slot after the one picked last
+
+    public:
+        RoundRobinPolicy();
+        int pickServer(const ServerPool& pool) override;
+        std::string getName() const override;
+};
+
+/**
+ * @class LeastRemainingTimePolicy
+ * @brief Sends the request to the server that will finish its assigned work soonest.
+ */
+class LeastRemainingTimePolicy : public DispatchPolicy {
+    public:
+        int pickServer(const ServerPool& pool) override;
+        std::string getName() const override;
+        bool needsLoadTracking() const override;
+};
+
+/**
+ * @class PowerOfTwoPolicy
+ * @brief Samples two random servers and picks the one with fewer outstanding requests.
+ */
+class PowerOfTwoPolicy : public DispatchPolicy {
+    private:
+        std::mt19937 rng;   ///< Engine for the two samples
+
+    public:
+        explicit PowerOfTwoPolicy(unsigned int seed);
+        int pickServer(const ServerPool& pool) override;
+        std::string getName() const override;
+};
+
+/**
+ * @class JoinIdleQueuePolicy
+ * @brief Sends the request to an idle server if there is one, otherwise to a random server with room.
+ */
+class JoinIdleQueuePolicy : public DispatchPolicy {
+    private:
+        std::mt19937 rng;   ///< Engine for the fallback random choice
+
+    public:
+        explicit JoinIdleQueuePolicy(unsigned int seed);
+        int pickServer(const ServerPool& pool) override;
+        bool prefersIdle() const override;
+        std::string getName() const override;
+};
+
+#endif
@@ -0,0 +1,48 @@
+/**
+ * @file EventQueue.cpp
+ * @brief Implementation of the EventQueue class.
+ */
+
+#include "EventQueue.h"
+#include <stdexcept>
+
+bool EventQueue::Later::operator()(const SimEvent& a, const SimEvent& b) const {
+    if (a.time != b.time) {
+        return a.time > b.time;
+    }
+    if (a.type != b.type) {
+        return a.type > b.type;
+    }
+    return a.seq > b.seq;
+}
+
+EventQueue::EventQueue() : nextSeq(0) {
+}
+
+void EventQueue::schedule(int time, EventType type) {
+    events.push(SimEvent{time, type, nextSeq++});
+}
+
+SimEvent EventQueue::pop() {
+    if (events.empty()) {
+        throw std::runtime_error("Event queue is empty");
+    }
+    SimEvent event = events.top();
+    events.pop();
+    return event;
+}
+
+int EventQueue::nextTime() const {
+    if (events.empty()) {
+        throw std::runtime_error("Event queue is empty");
+    }
+    return events.top().time;
+}
+
+bool EventQueue::isEmpty() const {
+    return events.empty();
+}
+
+int EventQueue::size() const {
+    return events.size();
+}
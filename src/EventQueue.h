@@ -0,0 +1,95 @@
+/**
+ * @file EventQueue.h
+ * @brief Declaration of the EventQueue class used by the event-driven simulation mode.
+ */
+
+#ifndef EVENTQUEUE_H
+#define EVENTQUEUE_H
+
+#include <queue>
+#include <vector>
+
+/**
+ * @enum EventType
+ * @brief Kinds of events scheduled by the event-driven simulation.
+ *
+ * Request completions are not scheduled here; the event loop reads the next
+ * completion cycle from the ServerPool's completion heap instead.
+ */
+enum class EventType {
+    Arrival,      ///< A new request arrives at this cycle
+    Dispatch,     ///< Queued requests should be handed to idle servers at this cycle
+    ScaleCheck,   ///< The scaling cooldown expires at this cycle
+    Status        ///< A periodic status snapshot is due at this cycle
+};
+
+/**
+ * @struct SimEvent
+ * @brief A single scheduled simulation event.
+ */
+struct SimEvent {
+    int time;            ///< Clock cycle at which the event fires
+    EventType type;      ///< Kind of event
+    long long seq;       ///< Insertion sequence number, used as a stable tie-breaker
+};
+
+/**
+ * @class EventQueue
+ * @brief Min-priority queue of SimEvent objects ordered by time and type.
+ *
+ * Events with the same time are returned in EventType declaration order, then
+ * in the order they were scheduled.
+ */
+class EventQueue {
+    private:
+        /**
+         * @brief Strict weak ordering that places the earliest event on top of the heap.
+         */
+        struct Later {
+            bool operator()(const SimEvent& a, const SimEvent& b) const;
+        };
+
+        std::priority_queue<SimEvent, std::vector<SimEvent>, Later> events; ///< Underlying binary heap
+        long long nextSeq;   ///< Sequence number assigned to the next scheduled event
+
+    public:
+        /**
+         * @brief Default constructor. Creates an empty event queue.
+         */
+        EventQueue();
+
+        /**
+         * @brief Schedules an event.
+         * @param time Clock cycle at which the event fires.
+         * @param type Kind of event.
+         */
+        void schedule(int time, EventType type);
+
+        /**
+         * @brief Removes and returns the earliest event.
+         * @return The earliest scheduled SimEvent.
+         * @throws std::runtime_error if the queue is empty.
+         */
+        SimEvent pop();
+
+        /**
+         * @brief Returns the clock cycle of the earliest event without removing it.
+         * @return Time of the earliest event.
+         * @throws std::runtime_error if the queue is empty.
+         */
+        int nextTime() const;
+
+        /**
+         * @brief Checks whether any events remain scheduled.
+         * @return true if no events are scheduled, false otherwise.
+         */
+        bool isEmpty() const;
+
+        /**
+         * @brief Returns the number of scheduled events.
+         * @return Event count.
+         */
+        int size() const;
+};
+
+#endif
@@ -0,0 +1,197 @@
+/**
+ * @file HeavyHitters.cpp
+ * @brief Implementation of the HeavyHitters class.
+ */
+
+#include "HeavyHitters.h"
+#include <algorithm>
+
+namespace {
+
+/// Odd multipliers for the per-row multiply-shift hashes.
+const uint64_t rowMultipliers[] = {
+    0x9E3779B97F4A7C15ULL, 0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL, 0xD6E8FEB86659FD93ULL
+};
+
+}
+
+HeavyHitters::HeavyHitters(int k)
+    : sketch(depthRows * sketchWidth, 0), entries(std::max(k, 1)), buckets(std::max(k, 1) + 1),
+      index(std::max(k, 1) * 2, 0), size(0), minBucket(-1), total(0) {
+        for (int i = buckets.size() - 1; i >= 0; i--) {
+            freeBuckets.push_back(i);
+        }
+    }
+
+size_t HeavyHitters::column(int row, uint32_t ip) {
+    return (static_cast<uint64_t>(ip) * rowMultipliers[row]) >> (64 - widthBits);
+}
+
+int HeavyHitters::find(uint32_t ip) const {
+    return index[index.probe(ip, IndexAccess{entries})] - 1;
+}
+
+void HeavyHitters::indexInsert(uint32_t ip, int entry) {
+    index[index.probe(ip, IndexAccess{entries})] = entry + 1;
+}
+
+void HeavyHitters::indexErase(uint32_t ip) {
+    IndexAccess access{entries};
+    index.erase(index.probe(ip, access), access);
+}
+
+int HeavyHitters::newBucket(uint32_t count, int after) {
+    int bucket = freeBuckets.back();
+    freeBuckets.pop_back();
+    int next = after < 0 ? minBucket : buckets[after].next;
+    buckets[bucket] = Bucket{count, -1, after, next};
+    if (next >= 0) {
+        buckets[next].prev = bucket;
+    }
+    if (after >= 0) {
+        buckets[after].next = bucket;
+    } else {
+        minBucket = bucket;
+    }
+    return bucket;
+}
+
+void HeavyHitters::detach(int entry) {
+    Entry& e = entries[entry];
+    Bucket& b = buckets[e.bucket];
+    if (e.prev >= 0) {
+        entries[e.prev].next = e.next;
+    } else {
+        b.head = e.next;
+    }
+    if (e.next >= 0) {
+        entries[e.next].prev = e.prev;
+    }
+    if (b.head < 0) {
+        if (b.prev >= 0) {
+            buckets[b.prev].next = b.next;
+        } else {
+            minBucket = b.next;
+        }
+        if (b.next >= 0) {
+            buckets[b.next].prev = b.prev;
+        }
+        freeBuckets.push_back(e.bucket);
+    }
+}
+
+void HeavyHitters::attach(int entry, int bucket) {
+    Entry& e = entries[entry];
+    e.bucket = bucket;
+    e.prev = -1;
+    e.next = buckets[bucket].head;
+    if (e.next >= 0) {
+        entries[e.next].prev = entry;
+    }
+    buckets[bucket].head = entry;
+}
+
+void HeavyHitters::increment(int entry) {
+    int from = entries[entry].bucket;
+    uint32_t count = buckets[from].count + 1;
+    int to = buckets[from].next;
+    bool alone = buckets[from].head == entry && entries[entry].next < 0;
+    if (alone && (to < 0 || buckets[to].count != count)) {
+        buckets[from].count = count;
+        return;
+    }
+    if (to < 0 || buckets[to].count != count) {
+        // the new bucket is linked before the old one can empty and be released
+        to = newBucket(count, from);
+    }
+    detach(entry);
+    attach(entry, to);
+}
+
+uint32_t HeavyHitters::record(uint32_t ip) {
+    total++;
+
+    uint32_t* counters[depthRows];
+    uint32_t smallest = UINT32_MAX;
+    for (int row = 0; row < depthRows; row++) {
+        counters[row] = &sketch[row * sketchWidth + column(row, ip)];
+        smallest = std::min(smallest, *counters[row]);
+    }
+    for (int row = 0; row < depthRows; row++) {
+        if (*counters[row] == smallest) {
+            (*counters[row])++;
+        }
+    }
+
+    int entry = find(ip);
+    if (entry >= 0) {
+        increment(entry);
+    } else if (size < static_cast<int>(entries.size())) {
+        entry = size++;
+        entries[entry].ip = ip;
+        entries[entry].error = 0;
+        int bucket = minBucket >= 0 && buckets[minBucket].count == 1 ? minBucket : newBucket(1, -1);
+        attach(entry, bucket);
+        indexInsert(ip, entry);
+    } else if (smallest + 1 > buckets[minBucket].count) {
+        // the least-counted entry is taken over and its count becomes the newcomer's error
+        entry = buckets[minBucket].head;
+        indexErase(entries[entry].ip);
+        entries[entry].ip = ip;
+        entries[entry].error = buckets[minBucket].count;
+        indexInsert(ip, entry);
+        increment(entry);
+    }
+    return smallest + 1;
+}
+
+uint32_t HeavyHitters::estimate(uint32_t ip) const {
+    uint32_t smallest = UINT32_MAX;
+    for (int row = 0; row < depthRows; row++) {
+        smallest = std::min(smallest, sketch[row * sketchWidth + column(row, ip)]);
+    }
+    return smallest;
+}
+
+uint32_t HeavyHitters::guaranteed(uint32_t ip) const {
+    int entry = find(ip);
+    if (entry < 0) {
+        return 0;
+    }
+    return buckets[entries[entry].bucket].count - entries[entry].error;
+}
+
+std::vector<Talker> HeavyHitters::top(int n) const {
+    std::vector<Talker> talkers;
+    for (int i = 0; i < size; i++) {
+        uint32_t count = buckets[entries[i].bucket].count;
+        uint32_t upper = entries[i].error == 0 ? count : estimate(entries[i].ip);
+        talkers.push_back(Talker{entries[i].ip, upper, count - entries[i].error});
+    }
+    std::sort(talkers.begin(), talkers.end(), [](const Talker& a, const Talker& b) {
+        if (a.estimate != b.estimate) {
+            return a.estimate > b.estimate;
+        }
+        return a.ip < b.ip;
+    });
+    if (static_cast<int>(talkers.size()) > n) {
+        talkers.resize(std::max(n, 0));
+    }
+    return talkers;
+}
+
+void HeavyHitters::clear() {
+    std::fill(sketch.begin(), sketch.end(), 0);
+    index.clear();
+    freeBuckets.clear();
+    for (int i = buckets.size() - 1; i >= 0; i--) {
+        freeBuckets.push_back(i);
+    }
+    size = 0;
+    minBucket = -1;
+    total = 0;
+}
+
+long long HeavyHitters::getTotal() const {
+    return total;
+}
@@ -0,0 +1,199 @@
+/**
+ * @file HeavyHitters.h
+ * @brief Declaration of the HeavyHitters class, a streaming top-K tracker of request sources.
+ */
+
+#ifndef HEAVYHITTERS_H
+#define HEAVYHITTERS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "OpenAddressTable.h"
+
+/**
+ * @struct Talker
+ * @brief One source among the heaviest seen, with bounds on its request count.
+ */
+struct Talker {
+    uint32_t ip;           ///< Source IPv4 address
+    uint32_t estimate;     ///< Upper bound on the requests it sent
+    uint32_t guaranteed;   ///< Lower bound on the requests it sent
+};
+
+/**
+ * @class HeavyHitters
+ * @brief Fixed-memory frequency estimates and top-K of source IPv4 addresses.
+ *
+ * Two summaries are fed every address, each in O(1):
+ *
+ * - A Count-Min sketch: depthRows rows of sketchWidth counters, one
+ *   multiply-shift hash per row. An address's estimate is the smallest of
+ *   its counters, which never undercounts. With conservative update only
+ *   the counters equal to that minimum are raised, which keeps the
+ *   overcount from colliding addresses low.
+ * - Space-Saving over k monitored addresses: a new address takes over the
+ *   entry with the smallest count and inherits that count as its error.
+ *   Entries are kept in a stream summary, buckets of equal count in
+ *   increasing order, so an increment moves an entry to the neighbouring
+ *   bucket instead of re-sorting.
+ *
+ * The sketch also filters the takeovers: an unmonitored address replaces
+ * an entry only if its estimate exceeds the smallest monitored count, since
+ * otherwise it cannot be heavier than the entry it would evict. Addresses
+ * from the long tail then cost a sketch update and one failed probe rather
+ * than churning the summary.
+ *
+ * top() reports the monitored addresses ranked by their sketch estimate,
+ * an upper bound, with the requests counted since they were last taken
+ * over as a lower bound; an entry never taken over is counted exactly.
+ */
+class HeavyHitters {
+    private:
+        static const int depthRows = 4;          ///< Count-Min rows
+        static const int widthBits = 12;         ///< log2 of the counters per row
+        static const int sketchWidth = 1 << widthBits;   ///< Counters per row
+
+        /**
+         * @struct Entry
+         * @brief One monitored address, linked into the bucket of its count.
+         */
+        struct Entry {
+            uint32_t ip;      ///< Monitored address
+            uint32_t error;   ///< Count inherited when the address took over the entry
+            int bucket;       ///< Bucket holding the entry
+            int prev;         ///< Previous entry in the bucket, or -1
+            int next;         ///< Next entry in the bucket, or -1
+        };
+
+        /**
+         * @struct Bucket
+         * @brief Entries sharing one count, in a list of buckets ordered by count.
+         */
+        struct Bucket {
+            uint32_t count;   ///< Count of every entry in the bucket
+            int head;         ///< First entry, or -1
+            int prev;         ///< Bucket with the next lower count, or -1
+            int next;         ///< Bucket with the next higher count, or -1
+        };
+
+        /**
+         * @struct IndexAccess
+         * @brief Tells OpenAddressTable which index slots are used and which address each one's entry monitors.
+         */
+        struct IndexAccess {
+            const std::vector<Entry>& entries;   ///< Entries the slots refer to
+            bool occupied(int slot) const { return slot != 0; }
+            uint32_t key(int slot) const { return entries[slot - 1].ip; }
+        };
+
+        std::vector<uint32_t> sketch;   ///< Count-Min counters, row by row
+        std::vector<Entry> entries;     ///< Monitored addresses; the first size are in use
+        std::vector<Bucket> buckets;    ///< Bucket pool: one per possible distinct count, plus one spare
+        std::vector<int> freeBuckets;   ///< Unused buckets
+        OpenAddressTable<int> index;    ///< Map from address to entry + 1 (0 = empty)
+        int size;                       ///< Entries in use
+        int minBucket;                  ///< Bucket with the smallest count, or -1
+        long long total;                ///< Addresses recorded since the last clear()
+
+        /**
+         * @brief Returns the sketch column of an address in one row.
+         * @param row Sketch row.
+         * @param ip Address.
+         * @return Column index.
+         */
+        static size_t column(int row, uint32_t ip);
+
+        /**
+         * @brief Finds the entry monitoring an address.
+         * @param ip Address.
+         * @return Entry index, or -1 if the address is not monitored.
+         */
+        int find(uint32_t ip) const;
+
+        /**
+         * @brief Adds an address to the entry index.
+         * @param ip Address, not already present.
+         * @param entry Entry monitoring it.
+         */
+        void indexInsert(uint32_t ip, int entry);
+
+        /**
+         * @brief Removes an address from the entry index, shifting its probe run back.
+         * @param ip Address, present in the index.
+         */
+        void indexErase(uint32_t ip);
+
+        /**
+         * @brief Takes a bucket from the pool and links it in after another.
+         * @param count Count of the new bucket.
+         * @param after Bucket to follow, or -1 to become the lowest.
+         * @return The new bucket.
+         */
+        int newBucket(uint32_t count, int after);
+
+        /**
+         * @brief Unlinks an entry from its bucket, returning the bucket to the pool if it empties.
+         * @param entry Entry to unlink.
+         */
+        void detach(int entry);
+
+        /**
+         * @brief Links an entry at the head of a bucket.
+         * @param entry Entry to link.
+         * @param bucket Bucket to join.
+         */
+        void attach(int entry, int bucket);
+
+        /**
+         * @brief Moves an entry to the bucket one count higher.
+         * @param entry Entry to increment.
+         */
+        void increment(int entry);
+
+    public:
+        /**
+         * @brief Creates an empty tracker.
+         * @param k Number of addresses to monitor (at least 1).
+         */
+        explicit HeavyHitters(int k);
+
+        /**
+         * @brief Records one request from an address.
+         * @param ip Source address.
+         * @return Upper bound on the requests from ip so far, this one included.
+         */
+        uint32_t record(uint32_t ip);
+
+        /**
+         * @brief Returns the sketch's upper bound on the requests from an address.
+         * @param ip Source address.
+         * @return Estimated request count.
+         */
+        uint32_t estimate(uint32_t ip) const;
+
+        /**
+         * @brief Returns the requests from an address counted since it was last taken over.
+         *
+         * Unlike estimate() this never overcounts, so it is safe to act on.
+         *
+         * @param ip Source address.
+         * @return Lower bound on the requests from ip, 0 if it is not monitored.
+         */
+        uint32_t guaranteed(uint32_t ip) const;
+
+        /**
+         * @brief Returns the monitored addresses, heaviest first.
+         * @param n Most addresses to return.
+         * @return Up to n talkers.
+         */
+        std::vector<Talker> top(int n) const;
+
+        /** @brief Forgets every address, keeping the allocated memory. */
+        void clear();
+
+        /** @brief Returns the number of addresses recorded since the last clear(). */
+        long long getTotal() const;
+};
+
+#endif
@@ -0,0 +1,125 @@
+/**
+ * @file IndexedHeap.cpp
+ * @brief Implementation of the IndexedHeap class.
+ */
+
+#include "IndexedHeap.h"
+#include <utility>
+
+IndexedHeap::IndexedHeap() {
+}
+
+bool IndexedHeap::before(int a, int b) const {
+    if (key[a] != key[b]) {
+        return key[a] < key[b];
+    }
+    return a < b;
+}
+
+void IndexedHeap::swapAt(int i, int j) {
+    std::swap(heap[i], heap[j]);
+    pos[heap[i]] = i;
+    pos[heap[j]] = j;
+}
+
+void IndexedHeap::siftUp(int i) {
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!before(heap[i], heap[parent])) {
+            break;
+        }
+        swapAt(i, parent);
+        i = parent;
+    }
+}
+
+void IndexedHeap::siftDown(int i) {
+    int n = heap.size();
+    while (true) {
+        int smallest = i;
+        int left = 2 * i + 1;
+        int right = left + 1;
+        if (left < n && before(heap[left], heap[smallest])) {
+            smallest = left;
+        }
+        if (right < n && before(heap[right], heap[smallest])) {
+            smallest = right;
+        }
+        if (smallest == i) {
+            break;
+        }
+        swapAt(i, smallest);
+        i = smallest;
+    }
+}
+
+void IndexedHeap::resize(int slots) {
+    pos.resize(slots, -1);
+    key.resize(slots, 0);
+}
+
+void IndexedHeap::push(int slot, int value) {
+    key[slot] = value;
+    if (pos[slot] >= 0) {
+        siftUp(pos[slot]);
+        siftDown(pos[slot]);
+        return;
+    }
+    pos[slot] = heap.size();
+    heap.push_back(slot);
+    siftUp(pos[slot]);
+}
+
+void IndexedHeap::remove(int slot) {
+    int i = pos[slot];
+    if (i < 0) {
+        return;
+    }
+    int last = heap.size() - 1;
+    if (i != last) {
+        swapAt(i, last);
+    }
+    heap.pop_back();
+    pos[slot] = -1;
+    if (i < static_cast<int>(heap.size())) {
+        siftUp(i);
+        siftDown(i);
+    }
+}
+
+int IndexedHeap::pop() {
+    if (heap.empty()) {
+        return -1;
+    }
+    int slot = heap[0];
+    remove(slot);
+    return slot;
+}
+
+int IndexedHeap::top() const {
+    return heap.empty() ? -1 : heap[0];
+}
+
+int IndexedHeap::topKey() const {
+    return key[heap[0]];
+}
+
+void IndexedHeap::moveSlot(int from, int to) {
+    key[to] = key[from];
+    pos[to] = pos[from];
+    pos[from] = -1;
+    if (pos[to] >= 0) {
+        heap[pos[to]] = to;
+        // the tie-break is the slot index, so the renumbered entry may need to move
+        siftUp(pos[to]);
+        siftDown(pos[to]);
+    }
+}
+
+bool IndexedHeap::contains(int slot) const {
+    return pos[slot] >= 0;
+}
+
+bool IndexedHeap::isEmpty() const {
+    return heap.empty();
+}
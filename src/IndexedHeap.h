@@ -0,0 +1,97 @@
+/**
+ * @file IndexedHeap.h
+ * @brief Declaration of the IndexedHeap class, a binary min-heap over server slots.
+ */
+
+#ifndef INDEXEDHEAP_H
+#define INDEXEDHEAP_H
+
+#include <vector>
+
+/**
+ * @class IndexedHeap
+ * @brief Binary min-heap of slot indices with per-slot integer keys.
+ *
+ * Each slot's position in the heap is tracked, so a slot's key can be changed
+ * or the slot removed in O(log n), and a slot can be renumbered in O(1) when
+ * the ServerPool compacts its arrays. Ties are broken by slot index.
+ */
+class IndexedHeap {
+    private:
+        std::vector<int> heap;   ///< Slots in heap order
+        std::vector<int> pos;    ///< Position of each slot in heap, or -1 if absent
+        std::vector<int> key;    ///< Key of each slot
+
+        /** @brief Returns true if slot a orders before slot b. */
+        bool before(int a, int b) const;
+
+        /** @brief Swaps two heap positions and updates pos. */
+        void swapAt(int i, int j);
+
+        /** @brief Restores the heap property upward from position i. */
+        void siftUp(int i);
+
+        /** @brief Restores the heap property downward from position i. */
+        void siftDown(int i);
+
+    public:
+        /**
+         * @brief Default constructor. Creates an empty heap.
+         */
+        IndexedHeap();
+
+        /**
+         * @brief Grows or shrinks the per-slot index to cover slots [0, slots).
+         *
+         * Slots being dropped must not be in the heap.
+         *
+         * @param slots Number of slots to track.
+         */
+        void resize(int slots);
+
+        /**
+         * @brief Inserts a slot, or updates its key if it is already present.
+         * @param slot Slot to insert.
+         * @param value Key for the slot.
+         */
+        void push(int slot, int value);
+
+        /**
+         * @brief Removes a slot if it is present.
+         * @param slot Slot to remove.
+         */
+        void remove(int slot);
+
+        /**
+         * @brief Removes and returns the slot with the smallest key.
+         * @return Slot index, or -1 if the heap is empty.
+         */
+        int pop();
+
+        /**
+         * @brief Returns the slot with the smallest key.
+         * @return Slot index, or -1 if the heap is empty.
+         */
+        int top() const;
+
+        /**
+         * @brief Returns the smallest key.
+         * @return Key of top(); undefined if the heap is empty.
+         */
+        int topKey() const;
+
+        /**
+         * @brief Moves slot from's entry to slot to, which must not be in the heap.
+         * @param from Slot being renumbered.
+         * @param to New slot index.
+         */
+        void moveSlot(int from, int to);
+
+        /** @brief Returns true if the slot is in the heap. */
+        bool contains(int slot) const;
+
+        /** @brief Returns true if the heap is empty. */
+        bool isEmpty() const;
+};
+
+#endif
@@ -7,11 +7,11 @@
 #include <sstream>
 
 IpRange::IpRange(const std::string& startIp, const std::string& endIp)
-    : startIp(startIp), endIp(endIp) {
+    : startIp(parse(startIp)), endIp(parse(endIp)) {
 }
 
-long IpRange::ipToNum(const std::string& ip) const {
-    long res = 0;
+uint32_t IpRange::parse(const std::string& ip) {
+    uint32_t res = 0;
     int part = 0;
 
     std::istringstream iss(ip);
@@ -25,15 +25,41 @@ long IpRange::ipToNum(const std::string& ip) const {
     return res;
 }
 
-bool IpRange::contains(const std::string& ip) const {
-    long ipNum = ipToNum(ip);
-    return ipNum >= ipToNum(startIp) && ipNum <= ipToNum(endIp);
+std::string IpRange::toString(uint32_t ip) {
+    char buffer[16];
+    char* out = buffer;
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        unsigned int octet = (ip >> shift) & 0xFF;
+        if (octet >= 100) {
+            *out++ = '0' + octet / 100;
+        }
+        if (octet >= 10) {
+            *out++ = '0' + octet / 10 % 10;
+        }
+        *out++ = '0' + octet % 10;
+        if (shift > 0) {
+            *out++ = '.';
+        }
+    }
+    return std::string(buffer, out - buffer);
 }
 
-std::string IpRange::getStartIp() const {
+bool IpRange::contains(uint32_t ip) const {
+    return ip >= startIp && ip <= endIp;
+}
+
+uint32_t IpRange::getStartAddress() const {
     return startIp;
 }
 
-std::string IpRange::getEndIp() const {
+uint32_t IpRange::getEndAddress() const {
     return endIp;
 }
+
+std::string IpRange::getStartIp() const {
+    return toString(startIp);
+}
+
+std::string IpRange::getEndIp() const {
+    return toString(endIp);
+}
@@ -6,27 +6,21 @@
 #ifndef IPRANGE_H
 #define IPRANGE_H
 
+#include <cstdint>
 #include <string>
 
 /**
  * @class IpRange
  * @brief Represents an inclusive range of IPv4 addresses used for IP blocking.
  *
- * Converts IPv4 addresses to numeric form for efficient range comparisons.
- * Used by the LoadBalancer to reject requests whose source IP falls within
- * a blocked range.
+ * The bounds are parsed once, at construction, into host-order 32-bit values,
+ * so contains() is two integer comparisons. Used by the LoadBalancer to reject
+ * requests whose source IP falls within a blocked range.
  */
 class IpRange{
     private:
-        std::string startIp;  ///< Lower bound of the IP range (inclusive)
-        std::string endIp;    ///< Upper bound of the IP range (inclusive)
-
-        /**
-         * @brief Converts a dotted-decimal IPv4 string to a 32-bit numeric value.
-         * @param ip IPv4 address string in "a.b.c.d" format.
-         * @return Numeric representation of the IP address.
-         */
-        long ipToNum(const std::string& ip) const;
+        uint32_t startIp;  ///< Lower bound of the IP range (inclusive)
+        uint32_t endIp;    ///< Upper bound of the IP range (inclusive)
 
     public:
         /**
@@ -38,10 +32,16 @@ class IpRange{
 
         /**
          * @brief Checks whether the given IP address falls within this range.
-         * @param ip IPv4 address to test, in "a.b.c.d" format.
+         * @param ip IPv4 address to test, in host byte order.
          * @return true if ip is within [startIp, endIp], false otherwise.
          */
-        bool contains(const std::string& ip) const;
+        bool contains(uint32_t ip) const;
+
+        /** @brief Returns the lower bound of the range in host byte order. */
+        uint32_t getStartAddress() const;
+
+        /** @brief Returns the upper bound of the range in host byte order. */
+        uint32_t getEndAddress() const;
 
         /**
          * @brief Returns the lower bound of the IP range.
@@ -54,6 +54,24 @@ class IpRange{
          * @return End IP address string.
          */
         std::string getEndIp() const;
+
+        /**
+         * @brief Converts a dotted-decimal IPv4 string to a 32-bit numeric value.
+         * @param ip IPv4 address string in "a.b.c.d" format.
+         * @return Numeric representation of the IP address in host byte order.
+         */
+        static uint32_t parse(const std::string& ip);
+
+        /**
+         * @brief Formats a 32-bit IPv4 address as a dotted-decimal string.
+         *
+         * The result is at most 15 characters, which fits the standard library's
+         * small-string buffer, so formatting does not allocate.
+         *
+         * @param ip IPv4 address in host byte order.
+         * @return Address in "a.b.c.d" format.
+         */
+        static std::string toString(uint32_t ip);
 };
 
 #endif
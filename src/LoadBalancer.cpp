@@ -4,111 +4,512 @@
  */
 
 #include "LoadBalancer.h"
+#include "Barrier.h"
 #include <iostream>
 #include <random>
-#include <cstdlib>
+#include <algorithm>
+#include <thread>
 
 LoadBalancer::LoadBalancer(const Config& config, LogFile* logFile)
-    : config(config), logFile(logFile), currTime(0), nextServerId(1), lastScaleTime(0) {
+    : ingress(config.getIngressQueueSize()), autoBlockWindowStart(0),
+      config(config), logFile(logFile), currTime(0), nextServerId(1), lastScaleTime(0),
+      eventDriven(config.getSimulationMode() == "event"), pendingScaleCheck(-1),
+      pendingArrivals(0), arrivalCount(0), serverCycles(0), serverCyclesTime(0), nextShard(0), routedQueueDepth(0) {
         blockedIpRanges = config.getBlockedIpRanges();
+        blocklist = Blocklist(blockedIpRanges);
+        if (config.getBlocklistReloadInterval() > 0){
+            blocklistWatcher.reset(new BlocklistWatcher(config, config.getBlocklistReloadInterval()));
+        } else if (!config.getBlocklistFile().empty()){
+            prefixBlocklist.reset(new CidrTrie());
+            if (!prefixBlocklist->loadFile(config.getBlocklistFile())){
+                std::cerr << "Could not read blocklist file " << config.getBlocklistFile() << std::endl;
+            }
+            for (const IpRange& range : blockedIpRanges){
+                prefixBlocklist->addRange(range.getStartAddress(), range.getEndAddress());
+            }
+            prefixBlocklist->build();
+        }
+        if (config.getRateLimit() > 0){
+            rateLimiter.reset(new RateLimiter(config.getRateLimit(), config.getRateLimitBurst(), config.getRateLimitSources()));
+        }
+        if (config.getTopTalkers() > 0){
+            // monitor more sources than are reported so the reported ones are settled
+            talkers.reset(new HeavyHitters(std::max(config.getTopTalkers() * 8, 64)));
+        }
+        if (config.getAutoBlockThreshold() > 0){
+            windowTalkers.reset(new HeavyHitters(16));
+        }
+        if (!config.getMetricsFile().empty()){
+            const std::string& format = config.getMetricsFormat();
+            if (format != "binary" && format != "csv"){
+                std::cerr << "Unknown metrics format '" << format << "', using binary" << std::endl;
+            }
+            metrics.reset(new MetricsRecorder(config.getMetricsFile(), config.getMetricsInterval(),
+                                              config.getTotalRunTime(), format == "csv"));
+            if (!metrics->isOpen()){
+                std::cerr << "Could not create metrics file " << config.getMetricsFile() << std::endl;
+                metrics.reset();
+            }
+        }
+        ingressBatch.resize(ingress.capacity());
+        if (config.getSpillHighWaterMark() > 0 && config.getSimulationMode() != "parallel"){
+            requestQueue.enableSpill(config.getSpillHighWaterMark(), config.getSpillDirectory(), config.getSpillSegmentSize());
+        }
+
+        unsigned int seed = config.getSeed();
+        if (seed == 0){
+            seed = std::random_device{}();
+        }
+        rng.seed(seed);
+
+        dispatchPolicy = DispatchPolicy::create(config.getDispatchPolicy(), rng());
+        if (!dispatchPolicy){
+            std::cerr << "Unknown dispatch policy '" << config.getDispatchPolicy() << "', using first-idle" << std::endl;
+            dispatchPolicy = DispatchPolicy::create("first-idle", 0);
+        }
+        // shards only ever hand requests to idle servers, so the summary must not name another policy
+        int localQueueSize = config.getLocalQueueSize();
+        if (config.getSimulationMode() == "parallel" && (dispatchPolicy->getName() != "first-idle" || localQueueSize > 0)){
+            std::cerr << "Parallel mode dispatches to idle servers only; ignoring dispatchPolicy="
+                      << dispatchPolicy->getName() << " and localQueueSize=" << localQueueSize << std::endl;
+            dispatchPolicy = DispatchPolicy::create("first-idle", 0);
+            localQueueSize = 0;
+        }
+        servers = ServerPool(eventDriven, localQueueSize, dispatchPolicy->needsLoadTracking());
+
+        uint64_t generatorSeed = (static_cast<uint64_t>(rng()) << 32) | rng();
+        requestGenerator = RequestGenerator::create(config.getRequestGenerator(), generatorSeed,
+                                                    config.getMinProcessTime(), config.getMaxProcessTime());
+        if (!requestGenerator){
+            std::cerr << "Unknown request generator '" << config.getRequestGenerator() << "', using xoshiro256" << std::endl;
+            requestGenerator = RequestGenerator::create("xoshiro256", generatorSeed,
+                                                        config.getMinProcessTime(), config.getMaxProcessTime());
+        }
+
+        arrivals = ArrivalProcess::create(config.getArrivalProcess(), config, rng());
+        if (!arrivals){
+            std::cerr << "Unknown arrival process '" << config.getArrivalProcess() << "', using bernoulli" << std::endl;
+            arrivals = ArrivalProcess::create("bernoulli", config, rng());
+        }
+
+        unsigned int shedSeed = rng();
+        shedPolicy = ShedPolicy::create(config.getShedPolicy(), config, shedSeed);
+        if (!shedPolicy){
+            std::cerr << "Unknown shed policy '" << config.getShedPolicy() << "', using drop-tail" << std::endl;
+            shedPolicy = ShedPolicy::create("drop-tail", config, shedSeed);
+        }
+
+        autoscaler = Autoscaler::create(config.getAutoscaler(), config);
+        if (!autoscaler){
+            std::cerr << "Unknown autoscaler '" << config.getAutoscaler() << "', using threshold" << std::endl;
+            autoscaler = Autoscaler::create("threshold", config);
+        }
+
+        if (config.getSimulationMode() == "parallel"){
+            shards.resize(std::max(config.getWorkerThreads(), 1));
+        }
     }
 
-LoadBalancer::~LoadBalancer() {
-    for (WebServer* server : servers) {
-        delete server;
+bool LoadBalancer::isIpBlocked(uint32_t ip) const {
+    // auto-blocked sources stay blocked whichever blocklist is in use
+    if (!autoBlocked.empty() && autoBlocked.count(ip)){
+        return true;
     }
-    servers.clear();
-}   
+    if (blocklistWatcher){
+        return blocklistWatcher->contains(ip);
+    }
+    return prefixBlocklist ? prefixBlocklist->containsV4(ip) : blocklist.contains(ip);
+}
 
-bool LoadBalancer::isIpBlocked(const std::string& ip) const {
-    for (const IpRange& range : blockedIpRanges){
-        if(range.contains(ip)){
-            return true;
-        }
+bool LoadBalancer::isRateLimited(uint32_t ip, int cycle) {
+    return rateLimiter && !rateLimiter->allow(ip, cycle);
+}
+
+uint32_t LoadBalancer::crossesAutoBlock(uint32_t ip, int cycle) {
+    if (!windowTalkers){
+        return 0;
+    }
+    int window = std::max(config.getAutoBlockWindow(), 1);
+    if (cycle - autoBlockWindowStart >= window){
+        windowTalkers->clear();
+        autoBlockWindowStart = cycle - (cycle - autoBlockWindowStart) % window;
+    }
+    // the sketch estimate overcounts colliding sources, so only a count that cannot exceed the truth may block
+    windowTalkers->record(ip);
+    uint32_t count = windowTalkers->guaranteed(ip);
+    if (count < static_cast<uint32_t>(config.getAutoBlockThreshold())){
+        return 0;
+    }
+    autoBlocked.insert(ip);
+    return count;
+}
+
+RejectKind LoadBalancer::screenArrival(Request& request, int cycle, uint32_t& windowCount) {
+    uint32_t ip = request.getIpIn();
+    windowCount = 0;
+    if (talkers){
+        talkers->record(ip);
+    }
+    if (isIpBlocked(ip)){
+        return RejectKind::Blocked;
+    }
+    windowCount = crossesAutoBlock(ip, cycle);
+    if (windowCount > 0){
+        return RejectKind::AutoBlocked;
+    }
+    if (isRateLimited(ip, cycle)){
+        return RejectKind::RateLimited;
+    }
+    request.setArrivalTime(cycle);
+    return RejectKind::None;
+}
+
+void LoadBalancer::logRejection(const RejectedArrival& rejected) {
+    switch (rejected.kind){
+        case RejectKind::Blocked:
+            logFile->logRequestBlocked(rejected.cycle, rejected.ip);
+            break;
+        case RejectKind::AutoBlocked:
+            logFile->logSourceAutoBlocked(rejected.cycle, rejected.ip, rejected.count, config.getAutoBlockWindow());
+            break;
+        case RejectKind::RateLimited:
+            logFile->logRequestRateLimited(rejected.cycle, rejected.ip);
+            break;
+        case RejectKind::Shed:
+            logFile->logRequestShed(rejected.cycle, rejected.ip, rejected.shedReason);
+            break;
+        case RejectKind::None:
+            break;
+    }
+}
+
+void LoadBalancer::logTopTalkers(int cycle) {
+    if (talkers){
+        logFile->logTopTalkers(cycle, talkers->top(config.getTopTalkers()));
     }
-    return false;
+}
+
+void LoadBalancer::logLatency(int cycle) {
+    logFile->logLatency(cycle, timings.getIntervalWaits(), timings.getIntervalLatencies());
+    timings.clearInterval();
+}
+
+void LoadBalancer::recordMetrics() {
+    if (!metrics){
+        return;
+    }
+    int busy = servers.size() - servers.idleCount();
+    for (const Shard& shard : shards){
+        busy += shard.getServers().size() - shard.getServers().idleCount();
+    }
+    metrics->record(currTime, MetricsSample{getQueueSize(), getServerCount(), busy, arrivalCount,
+                                            logFile->getRequestsProcessed(), logFile->getRequestsBlocked(),
+                                            logFile->getRequestsShed() + logFile->getRequestsRateLimited(),
+                                            logFile->getServersCreated(), logFile->getServersDeleted()});
 }
 
 bool LoadBalancer::canScaleUp() const {
     return (currTime - lastScaleTime) >= config.getScaleCooldownTime();
 }
 
+void LoadBalancer::accountServerCycles() {
+    serverCycles += static_cast<long long>(getServerCount()) * (currTime - serverCyclesTime);
+    serverCyclesTime = currTime;
+}
+
 void LoadBalancer::addServer() {
-    WebServer* newServer = new WebServer(nextServerId++);
-    servers.push_back(newServer);
-    logFile->logServerAdded(currTime, newServer->getServerId());
+    accountServerCycles();
+    int serverId = nextServerId++;
+    if (shards.empty()){
+        servers.add(serverId);
+    } else {
+        // new capacity goes to the smallest shard so the partitions stay even
+        size_t target = 0;
+        for (size_t i = 1; i < shards.size(); i++){
+            if (shards[i].getServers().size() < shards[target].getServers().size()){
+                target = i;
+            }
+        }
+        shards[target].getServers().add(serverId);
+    }
+    logFile->logServerAdded(currTime, serverId);
     lastScaleTime = currTime;
+
+    if (eventDriven) {
+        events.schedule(currTime + 1, EventType::Dispatch);
+    }
 }
 
 bool LoadBalancer::removeServer() {
-    if(servers.size() <= 1){
+    if(getServerCount() <= 1){
         return false;
     }
-    for(auto i = 0; i < servers.size(); i++){
-        if(!servers[i]->isBusy()){
-            int serverId = servers[i]->getServerId();
-            delete servers[i];
-            servers.erase(servers.begin() + i);
-            logFile->logServerRemoved(currTime, serverId);
-            lastScaleTime = currTime;
+    accountServerCycles();
+    int serverId = -1;
+    if (shards.empty()){
+        serverId = servers.removeIdle();
+    } else {
+        // take the idle server from the largest shard that has one
+        int target = -1;
+        for (size_t i = 0; i < shards.size(); i++){
+            const ServerPool& pool = shards[i].getServers();
+            if (pool.idleCount() > 0 && (target < 0 || pool.size() > shards[target].getServers().size())){
+                target = i;
+            }
+        }
+        if (target >= 0){
+            serverId = shards[target].getServers().removeIdle();
+        }
+    }
+    if (serverId < 0){
+        return false;
+    }
+    logFile->logServerRemoved(currTime, serverId);
+    timings.removeServer(serverId);
+    lastScaleTime = currTime;
+    return true;
+}
+
+bool LoadBalancer::hasIdleServer() const {
+    for (const Shard& shard : shards){
+        if (shard.getServers().idleCount() > 0){
             return true;
         }
     }
-    return false;
+    return servers.idleCount() > 0;
 }
 
 void LoadBalancer::checkAndScale() {
-    if (!canScaleUp()){
+    int queueSize = getQueueSize();
+    int serverCount = getServerCount();
+    logFile->recordQueueDepth(currTime, queueSize);
+
+    ScaleDecision decision = autoscaler->decide(currTime, queueSize, serverCount);
+    bool wantUp = decision.delta > 0;
+    bool wantDown = decision.delta < 0 && serverCount > 1 && hasIdleServer();
+    if (!wantUp && !wantDown){
         return;
     }
 
-    int queueSize = requestQueue.size();
-    int serverCount = servers.size();
-    int minQueue = config.getMinQueuePerServer() * serverCount;
-    int maxQueue = config.getMaxQueuePerServer() * serverCount;
+    if (!canScaleUp()){
+        int readyTime = lastScaleTime + config.getScaleCooldownTime();
+        if (eventDriven && pendingScaleCheck != readyTime){
+            events.schedule(readyTime, EventType::ScaleCheck);
+            pendingScaleCheck = readyTime;
+        }
+        return;
+    }
 
-    if (queueSize > maxQueue){
-        logFile->logEvent(currTime, "SCALE UP: Queue size exceeds max threshold, adding server");
-        addServer();
-    } else if (queueSize < minQueue && serverCount > 1){
-        logFile->logEvent(currTime, "SCALE DOWN: Queue size below min threshold, removing server");
-        removeServer();
+    std::string reason = decision.reason;
+    if (decision.target > 0){
+        reason += " (target " + std::to_string(decision.target) + ")";
+    }
+    if (wantUp){
+        logFile->logEvent(currTime, "SCALE UP: " + reason, LogCategory::Scaling);
+        for (int i = 0; i < decision.delta; i++){
+            addServer();
+        }
+    } else {
+        logFile->logEvent(currTime, "SCALE DOWN: " + reason, LogCategory::Scaling);
+        for (int i = 0; i > decision.delta; i--){
+            if (!removeServer()){
+                break;
+            }
+        }
     }
 }
 
 void LoadBalancer::distributeRequests() {
-    for (WebServer* server : servers){
-        if (!server->isBusy() && !requestQueue.isEmpty()){
-            Request req = requestQueue.pop();
-            server->assignRequest(req);
+    // policies that always take an idle server first get the whole idle set in one batch
+    bool checkDequeue = shedPolicy->shedsOnDequeue();
+    if (dispatchPolicy->prefersIdle() && !checkDequeue){
+        int count = std::min(requestQueue.size(), servers.idleCount());
+        if (count > 0){
+            dispatchBatch.resize(count);
+            dispatchSlots.resize(count);
+            requestQueue.popBatch(dispatchBatch.data(), count);
+            servers.assignIdle(dispatchBatch.data(), dispatchSlots.data(), count, currTime);
+            for (int i = 0; i < count; i++){
+                requestStarted(servers.getServerId(dispatchSlots[i]), dispatchBatch[i], currTime);
+            }
+        }
+    }
 
-            logFile->logRequestStarted(currTime, server->getServerId(), req.getIpIn(), req.getIpOut(), req.getProcessTime());
+    Request req;
+    while (!requestQueue.isEmpty()){
+        int slot = dispatchPolicy->pickServer(servers);
+        if (slot < 0){
+            break;
+        }
+        requestQueue.tryPop(req);
+        if (checkDequeue && shedPolicy->onDequeue(currTime - req.getArrivalTime(), requestQueue.size(), currTime)){
+            logFile->logRequestShed(currTime, req.getIpIn(), "queue wait over target");
+            continue;
+        }
+        if (servers.enqueue(slot, req, currTime)){
+            requestStarted(servers.getServerId(slot), req, currTime);
         }
     }
 }
 
+void LoadBalancer::requestStarted(int serverId, const Request& request, int cycle) {
+    logFile->logRequestStarted(cycle, serverId, request.getIpIn(), request.getIpOut(), request.getProcessTime());
+    timings.recordStart(request, cycle);
+}
+
+void LoadBalancer::completeRequest(int slot) {
+    const Request& req = servers.getRequest(slot);
+    logFile->logRequestProcessed(currTime, servers.getServerId(slot), req.getIpIn(), req.getIpOut(), req.getProcessTime());
+    timings.recordCompletion(req, servers.getServerId(slot), currTime);
+    autoscaler->recordCompletion(std::max(req.getProcessTime(), 1));
+    if (servers.release(slot, currTime)){
+        requestStarted(servers.getServerId(slot), servers.getRequest(slot), currTime);
+    }
+}
+
 void LoadBalancer::processServers() {
-    for (WebServer* server : servers){
-        if (server->isBusy()){
-            bool completed = server->advanceClockCycle();
-            if (completed){
-                Request req = server->getCurrentRequest();
-                logFile->logRequestProcessed(currTime, server->getServerId(),req.getIpIn(), req.getIpOut(), req.getProcessTime());                
-                server->setIdle();
-            }
+    if (eventDriven){
+        int slot;
+        while ((slot = servers.popCompleted(currTime)) >= 0){
+            completeRequest(slot);
+        }
+        return;
+    }
+
+    if (servers.advanceClockCycle(completedMask) == 0){
+        return;
+    }
+    for (size_t word = 0; word < completedMask.size(); word++){
+        uint64_t bits = completedMask[word];
+        while (bits != 0){
+            completeRequest(word * 64 + __builtin_ctzll(bits));
+            bits &= bits - 1;
         }
     }
 }
 
-void LoadBalancer::addNewRequest() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_real_distribution<> dis(0.0, 1.0);
+void LoadBalancer::addArrivals(int count) {
+    if (count <= 0){
+        return;
+    }
+    arrivalBatch.resize(count);
+    requestGenerator->fill(arrivalBatch.data(), count);
+    admitBatch(arrivalBatch.data(), count);
+}
 
-    if(dis(gen) < config.getNewRequestProb()){
-        Request newReq = Request::generateRandomRequest(config.getMinProcessTime(), config.getMaxProcessTime());
-        addRequest(newReq);
+void LoadBalancer::admitBatch(Request* batch, int count) {
+    arrivalCount += count;
+    // compact the accepted requests to the front so the whole batch is queued in one call
+    int accepted = 0;
+    for (int i = 0; i < count; i++){
+        uint32_t windowCount;
+        RejectKind kind = screenArrival(batch[i], currTime, windowCount);
+        if (kind != RejectKind::None){
+            logRejection(RejectedArrival{currTime, batch[i].getIpIn(), kind, nullptr, windowCount});
+            continue;
+        }
+        batch[accepted++] = batch[i];
     }
+    // the autoscaler sees the offered load, shed requests included
+    autoscaler->recordArrivals(accepted);
+    if (shedPolicy->getMaxDepth() == 0){
+        requestQueue.pushBatch(batch, accepted);
+        return;
+    }
+    for (int i = 0; i < accepted; i++){
+        admitRequest(batch[i]);
+    }
+}
+
+bool LoadBalancer::admitRequest(const Request& request) {
+    switch (shedPolicy->onArrival(requestQueue.size())){
+        case ShedAction::DropArrival:
+            logFile->logRequestShed(currTime, request.getIpIn(),
+                                    requestQueue.size() >= shedPolicy->getMaxDepth() ? "queue full" : "early drop");
+            return false;
+        case ShedAction::DropOldest: {
+            Request oldest = requestQueue.pop();
+            logFile->logRequestShed(currTime, oldest.getIpIn(), "evicted by newer request");
+            break;
+        }
+        case ShedAction::Admit:
+            break;
+    }
+    requestQueue.push(request);
+    return true;
+}
+
+void LoadBalancer::routeArrival(int cycle, Request& request) {
+    arrivalCount++;
+    uint32_t windowCount;
+    RejectKind kind = screenArrival(request, cycle, windowCount);
+    if (kind != RejectKind::None){
+        rejectedArrivals.push_back(RejectedArrival{cycle, request.getIpIn(), kind, nullptr, windowCount});
+        return;
+    }
+    autoscaler->recordArrivals(1);
+
+    ShedAction action = shedPolicy->onArrival(routedQueueDepth);
+    if (action == ShedAction::DropOldest){
+        // evict from the longest shard queue; if every queue is empty the backlog is this epoch's arrivals
+        int longest = longestShardQueue();
+        if (longest < 0){
+            action = ShedAction::DropArrival;
+        } else {
+            Request oldest = shards[longest].getQueue().pop();
+            rejectedArrivals.push_back(RejectedArrival{cycle, oldest.getIpIn(), RejectKind::Shed, "evicted by newer request"});
+            routedQueueDepth--;
+        }
+    }
+    if (action == ShedAction::DropArrival){
+        const char* reason = routedQueueDepth >= shedPolicy->getMaxDepth() ? "queue full" : "early drop";
+        rejectedArrivals.push_back(RejectedArrival{cycle, request.getIpIn(), RejectKind::Shed, reason});
+        return;
+    }
+
+    routedQueueDepth++;
+    shards[nextShard].addArrival(cycle, request);
+    nextShard = (nextShard + 1) % shards.size();
+}
+
+void LoadBalancer::drainIngress() {
+    if (ingress.sizeApprox() == 0){
+        return;
+    }
+    int count = 0;
+    while (count < static_cast<int>(ingressBatch.size()) && ingress.tryPop(ingressBatch[count])){
+        count++;
+    }
+    if (shards.empty()){
+        admitBatch(ingressBatch.data(), count);
+        return;
+    }
+    for (int i = 0; i < count; i++){
+        routeArrival(currTime, ingressBatch[i]);
+    }
+}
+
+bool LoadBalancer::submit(const Request& request) {
+    return ingress.tryPush(request);
+}
+
+void LoadBalancer::scheduleNextArrival(int fromTime) {
+    int cycle = arrivals->nextArrival(fromTime, config.getTotalRunTime(), pendingArrivals);
+    if (cycle >= 0){
+        events.schedule(cycle, EventType::Arrival);
+    }
+}
+
+int LoadBalancer::nextEventTime() const {
+    int next = servers.nextCompletionTime();
+    if (!events.isEmpty() && (next < 0 || events.nextTime() < next)){
+        next = events.nextTime();
+    }
+    // requests submitted from other threads are drained on the next cycle, as in the tick loop
+    if (ingress.sizeApprox() > 0 && (next < 0 || currTime + 1 < next)){
+        next = currTime + 1;
+    }
+    return next;
 }
 
 void LoadBalancer::init() {
@@ -120,13 +521,17 @@ void LoadBalancer::init() {
     }
 
     int initQueueSize = initServers * 100;
-    for (int i = 0; i < initQueueSize; i++){
-        Request newReq = Request::generateRandomRequest(config.getMinProcessTime(), config.getMaxProcessTime());
+    std::vector<Request> initial(initQueueSize);
+    if (shards.empty()){
+        requestQueue.reserve(initQueueSize);
+    }
+    requestGenerator->fill(initial.data(), initQueueSize);
+    for (const Request& newReq : initial){
         addRequest(newReq);
     }
 
     logFile->logEvent(currTime, "Initialization complete");
-    logFile->logStatus(currTime, requestQueue.size(), servers.size());
+    logFile->logStatus(currTime, getQueueSize(), getServerCount());
 }
 
 void LoadBalancer::run() {
@@ -139,19 +544,15 @@ void LoadBalancer::run() {
 
     logFile->logEvent(currTime, "RUN: Starting simulation");
 
-    while (currTime < totalRunTime){
-        addNewRequest();
-        processServers();
-        distributeRequests();
-        checkAndScale();
-
-        if (currTime % statusInterval == 0){
-            logFile->logStatus(currTime, requestQueue.size(), servers.size());
-        }
-
-        currTime++;
+    if (eventDriven){
+        runEvents(totalRunTime, statusInterval);
+    } else if (!shards.empty()){
+        runParallel(totalRunTime, statusInterval);
+    } else {
+        runTicks(totalRunTime, statusInterval);
     }
 
+    accountServerCycles();
     logFile->logEvent(currTime, "RUN: Simulation complete");
     
     std::string ipStart = "N/A";
@@ -173,26 +574,279 @@ void LoadBalancer::run() {
         ipStart, 
         ipEnd
     );
-    logFile->writeSummary(currTime, servers.size(), requestQueue.size());
+    logFile->writeSummary(currTime, getServerCount(), getQueueSize(), autoscaler->getName(),
+                          dispatchPolicy->getName(), shedPolicy->getName(), timings,
+                          talkers ? talkers->top(config.getTopTalkers()) : std::vector<Talker>());
+    if (metrics && !metrics->finish(currTime)){
+        std::cerr << "Could not write metrics file " << config.getMetricsFile() << std::endl;
+    }
+}
+
+void LoadBalancer::runTicks(int totalRunTime, int statusInterval) {
+    while (currTime < totalRunTime){
+        addArrivals(arrivals->sample(currTime));
+        drainIngress();
+        processServers();
+        distributeRequests();
+        checkAndScale();
+        recordMetrics();
+
+        if (currTime % statusInterval == 0){
+            logFile->logStatus(currTime, getQueueSize(), getServerCount());
+            logTopTalkers(currTime);
+            logLatency(currTime);
+        }
+
+        currTime++;
+    }
+}
+
+void LoadBalancer::runEvents(int totalRunTime, int statusInterval) {
+    scheduleNextArrival(currTime);
+    events.schedule(currTime, EventType::Dispatch);
+    events.schedule(currTime, EventType::Status);
+
+    int next;
+    while ((next = nextEventTime()) >= 0 && next < totalRunTime){
+        currTime = next;
+        bool statusDue = false;
+
+        // arrivals pop first, so they are logged before this cycle's completions as in the tick loop
+        while (!events.isEmpty() && events.nextTime() == currTime){
+            SimEvent event = events.pop();
+
+            switch (event.type){
+                case EventType::Arrival:
+                    addArrivals(pendingArrivals);
+                    scheduleNextArrival(currTime + 1);
+                    break;
+                case EventType::ScaleCheck:
+                    pendingScaleCheck = -1;
+                    break;
+                case EventType::Status:
+                    statusDue = true;
+                    events.schedule(currTime + statusInterval, EventType::Status);
+                    break;
+                case EventType::Dispatch:
+                    break;
+            }
+        }
+
+        drainIngress();
+        processServers();
+        distributeRequests();
+        checkAndScale();
+        recordMetrics();
+
+        if (statusDue){
+            logFile->logStatus(currTime, getQueueSize(), getServerCount());
+            logTopTalkers(currTime);
+            logLatency(currTime);
+        }
+    }
+
+    currTime = totalRunTime;
+}
+
+void LoadBalancer::runParallel(int totalRunTime, int statusInterval) {
+    int shardCount = shards.size();
+    int epoch = std::max(config.getShardEpoch(), 1);
+    int epochStart = currTime;
+    int epochEnd = currTime;
+    bool stopping = false;
+
+    // the coordinator plus one worker per shard meet at the barrier twice per epoch
+    Barrier barrier(shardCount + 1);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < shardCount; i++){
+        workers.emplace_back([this, i, &barrier, &epochStart, &epochEnd, &stopping]() {
+            while (true){
+                barrier.wait();
+                if (stopping){
+                    return;
+                }
+                shards[i].runCycles(epochStart, epochEnd);
+                barrier.wait();
+            }
+        });
+    }
+
+    while (currTime < totalRunTime){
+        epochStart = currTime;
+        epochEnd = std::min(currTime + epoch, totalRunTime);
+
+        // arrivals are drawn on this thread so the request stream depends only on the seed
+        arrivalCounts.resize(epochEnd - epochStart);
+        arrivalBatch.resize(arrivals->sampleBlock(epochStart, epochEnd - epochStart, arrivalCounts.data()));
+        requestGenerator->fill(arrivalBatch.data(), arrivalBatch.size());
+        routedQueueDepth = 0;
+        for (const Shard& shard : shards){
+            routedQueueDepth += shard.getQueue().size();
+        }
+        drainIngress();
+        size_t nextRequest = 0;
+        for (int cycle = epochStart; cycle < epochEnd; cycle++){
+            for (int i = 0; i < arrivalCounts[cycle - epochStart]; i++){
+                routeArrival(cycle, arrivalBatch[nextRequest++]);
+            }
+        }
+
+        barrier.wait();
+        barrier.wait();
+
+        currTime = epochEnd - 1;
+        flushShardLogs(epochStart, epochEnd);
+        balanceShards();
+        checkAndScale();
+        recordMetrics();
+
+        // with epochs longer than one cycle, a status due inside the epoch reports the state at its end
+        int statusCycle = (currTime / statusInterval) * statusInterval;
+        if (statusCycle >= epochStart){
+            logFile->logStatus(statusCycle, getQueueSize(), getServerCount());
+            logTopTalkers(statusCycle);
+            logLatency(statusCycle);
+        }
+
+        currTime = epochEnd;
+    }
+
+    stopping = true;
+    barrier.wait();
+    for (std::thread& worker : workers){
+        worker.join();
+    }
+}
+
+void LoadBalancer::flushShardLogs(int fromTime, int toTime) {
+    std::vector<size_t> cursor(shards.size(), 0);
+    size_t nextRejected = 0;
+
+    // per cycle: rejected arrivals, then every shard's completions, then every shard's starts
+    for (int cycle = fromTime; cycle < toTime; cycle++){
+        while (nextRejected < rejectedArrivals.size() && rejectedArrivals[nextRejected].cycle == cycle){
+            logRejection(rejectedArrivals[nextRejected]);
+            nextRejected++;
+        }
+        for (size_t i = 0; i < shards.size(); i++){
+            const std::vector<ShardLogEntry>& entries = shards[i].getEntries();
+            while (cursor[i] < entries.size() && entries[cursor[i]].cycle == cycle && !entries[cursor[i]].started){
+                const ShardLogEntry& e = entries[cursor[i]];
+                logFile->logRequestProcessed(cycle, e.serverId, e.request.getIpIn(), e.request.getIpOut(), e.request.getProcessTime());
+                timings.recordCompletion(e.request, e.serverId, cycle);
+                autoscaler->recordCompletion(std::max(e.request.getProcessTime(), 1));
+                cursor[i]++;
+            }
+        }
+        for (size_t i = 0; i < shards.size(); i++){
+            const std::vector<ShardLogEntry>& entries = shards[i].getEntries();
+            while (cursor[i] < entries.size() && entries[cursor[i]].cycle == cycle){
+                const ShardLogEntry& e = entries[cursor[i]];
+                requestStarted(e.serverId, e.request, cycle);
+                cursor[i]++;
+            }
+        }
+    }
+
+    rejectedArrivals.clear();
+    for (Shard& shard : shards){
+        shard.clearEntries();
+    }
+}
+
+void LoadBalancer::balanceShards() {
+    // a shard's surplus is queued work it cannot start next cycle; a negative surplus means idle servers
+    std::vector<int> surplus(shards.size());
+    for (size_t i = 0; i < shards.size(); i++){
+        surplus[i] = shards[i].getQueue().size() - shards[i].getServers().idleCount();
+    }
+
+    size_t victim = 0;
+    for (size_t thief = 0; thief < shards.size(); thief++){
+        while (surplus[thief] < 0){
+            while (victim < shards.size() && surplus[victim] <= 0){
+                victim++;
+            }
+            if (victim == shards.size()){
+                return;
+            }
+            int moved = std::min(-surplus[thief], surplus[victim]);
+            for (int i = 0; i < moved; i++){
+                shards[thief].getQueue().push(shards[victim].getQueue().pop());
+            }
+            surplus[thief] += moved;
+            surplus[victim] -= moved;
+        }
+    }
 }
 
 bool LoadBalancer::addRequest(const Request& request) {
-    if(isIpBlocked(request.getIpIn())){
-        logFile->logRequestBlocked(currTime, request.getIpIn());
+    // counted like any arrival, so the metrics arrivals column covers the rejections logged here
+    arrivalCount++;
+    Request stamped = request;
+    uint32_t windowCount;
+    RejectKind kind = screenArrival(stamped, currTime, windowCount);
+    if (kind != RejectKind::None){
+        logRejection(RejectedArrival{currTime, stamped.getIpIn(), kind, nullptr, windowCount});
         return false;
     }
-    requestQueue.push(request);
+    if (shards.empty()){
+        return admitRequest(stamped);
+    }
+
+    int depth = 0;
+    for (const Shard& shard : shards){
+        depth += shard.getQueue().size();
+    }
+    ShedAction action = shedPolicy->onArrival(depth);
+    int longest = longestShardQueue();
+    if (action == ShedAction::DropOldest && longest >= 0){
+        Request oldest = shards[longest].getQueue().pop();
+        logFile->logRequestShed(currTime, oldest.getIpIn(), "evicted by newer request");
+    } else if (action != ShedAction::Admit){
+        logFile->logRequestShed(currTime, stamped.getIpIn(), depth >= shedPolicy->getMaxDepth() ? "queue full" : "early drop");
+        return false;
+    }
+    shards[nextShard].getQueue().push(stamped);
+    nextShard = (nextShard + 1) % shards.size();
     return true;
 }
 
+int LoadBalancer::longestShardQueue() const {
+    int longest = -1;
+    for (size_t i = 0; i < shards.size(); i++){
+        int size = shards[i].getQueue().size();
+        if (size > 0 && (longest < 0 || size > shards[longest].getQueue().size())){
+            longest = i;
+        }
+    }
+    return longest;
+}
+
 int LoadBalancer::getQueueSize() const {
-    return requestQueue.size();
+    int total = requestQueue.size() + servers.localQueuedCount() + ingress.sizeApprox();
+    for (const Shard& shard : shards){
+        total += shard.getQueue().size();
+    }
+    return total;
 }
 
 int LoadBalancer::getServerCount() const {
-    return servers.size();
+    int total = servers.size();
+    for (const Shard& shard : shards){
+        total += shard.getServers().size();
+    }
+    return total;
 }
 
 int LoadBalancer::getCurrTime() const {
     return currTime;
-}
\ No newline at end of file
+}
+
+const WaitStats& LoadBalancer::getWaitStats() const {
+    return timings.getWaits();
+}
+
+long long LoadBalancer::getServerCycles() const {
+    return serverCycles;
+}
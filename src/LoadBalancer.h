@@ -6,32 +6,107 @@
 #ifndef LOADBALANCER_H
 #define LOADBALANCER_H
 
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <utility>
 #include <vector>
+#include "ArrivalProcess.h"
+#include "Autoscaler.h"
+#include "Blocklist.h"
+#include "BlocklistWatcher.h"
+#include "CidrTrie.h"
+#include "DispatchPolicy.h"
+#include "EventQueue.h"
+#include "HeavyHitters.h"
 #include "Request.h"
+#include "RequestGenerator.h"
 #include "RequestQueue.h"
-#include "WebServer.h"
+#include "ConcurrentRequestQueue.h"
+#include "ServerPool.h"
+#include "ShedPolicy.h"
+#include "Shard.h"
 #include "IpRange.h"
 #include "Config.h"
 #include "LogFile.h"
+#include "MetricsRecorder.h"
+#include "RateLimiter.h"
+#include "RequestTimings.h"
+#include "WaitStats.h"
+
+/**
+ * @enum RejectKind
+ * @brief Why an arrival was turned away.
+ */
+enum class RejectKind {
+    None,         ///< It passed every source filter
+    Blocked,      ///< Its source IP is in the blocklist
+    AutoBlocked,  ///< Its source IP just crossed the auto-block threshold
+    RateLimited,  ///< Its source IP exceeded its rate limit
+    Shed          ///< Admission control dropped it
+};
+
+/**
+ * @struct RejectedArrival
+ * @brief An arrival blocked, rate limited or shed while routing to shards, awaiting logging (parallel mode).
+ */
+struct RejectedArrival {
+    int cycle;                ///< Clock cycle of the arrival
+    uint32_t ip;              ///< Source IPv4 address of the rejected request
+    RejectKind kind;          ///< Why the request was rejected
+    const char* shedReason;   ///< Why the request was shed, or nullptr unless kind is Shed
+    uint32_t count;           ///< Requests counted from the source in its window, or 0 unless kind is AutoBlocked
+};
 
 /**
  * @class LoadBalancer
  * @brief Orchestrates the simulation of a dynamically scaling server pool.
  *
  * On each clock cycle the LoadBalancer:
- *  1. Probabilistically generates a new incoming request.
+ *  1. Generates the cycle's arrivals, as many as the configured ArrivalProcess draws.
  *  2. Advances all busy servers by one clock cycle, completing requests where due.
- *  3. Distributes queued requests to idle servers (round-robin over available slots).
- *  4. Evaluates scaling thresholds and adds or removes servers as needed.
+ *  3. Distributes queued requests to servers chosen by the configured DispatchPolicy.
+ *  4. Asks the configured Autoscaler whether to add or remove servers.
  *
+ * With a non-zero localQueueSize a busy server may also accept requests into its
+ * own small queue, which it starts as soon as its current request finishes.
  * Requests originating from blocked IP ranges are silently dropped and logged.
  * Autoscaling is gated by a configurable cooldown period to prevent thrashing.
+ *
+ * In "event" simulation mode the same steps are driven by an EventQueue of
+ * arrival, completion, dispatch, scaling and status events, and the clock jumps
+ * straight to the next cycle on which something happens instead of visiting
+ * every cycle.
+ *
+ * In "parallel" mode the pool is split into workerThreads Shards, each with its
+ * own local queue and worker thread. Shards run independently for shardEpoch
+ * cycles, then meet at a barrier where the coordinating thread replays their
+ * log entries in a fixed order, moves queued requests from overloaded shards to
+ * shards with idle servers, and makes the global scaling decision. Runs with the
+ * same seed and thread count produce identical logs. Shards always dispatch to
+ * their own idle servers; dispatch policies apply to the other two modes.
+ * Admission control runs as arrivals are routed, against the shard queues'
+ * depth at the epoch start plus the requests routed since, so codel's
+ * dequeue-side shedding applies only to the other two modes.
  */
 class LoadBalancer{
     private:
-        std::vector<WebServer*> servers;    ///< Pool of dynamically managed server instances
+        ServerPool servers;                 ///< Pool of dynamically managed server instances
+        std::vector<uint64_t> completedMask; ///< Scratch bitmask of slots finished this cycle (tick mode)
         RequestQueue requestQueue;          ///< FIFO queue of pending requests
-        std::vector<IpRange> blockedIpRanges; ///< IP ranges that are filtered at ingress
+        ConcurrentRequestQueue ingress;     ///< Requests submitted by other threads, drained once per cycle
+        std::vector<Request> ingressBatch;  ///< Scratch buffer for the requests drained from ingress together
+        std::vector<IpRange> blockedIpRanges; ///< IP ranges that are filtered at ingress, as configured
+        Blocklist blocklist;                ///< blockedIpRanges compiled for lookup
+        std::unique_ptr<CidrTrie> prefixBlocklist; ///< blocklistFile and blockedIpRanges compiled together, if a file is configured
+        std::unique_ptr<BlocklistWatcher> blocklistWatcher; ///< Hot-reloaded blocklist, if blocklistReloadInterval is set; replaces the two above
+        std::unique_ptr<RateLimiter> rateLimiter;  ///< Per-source token buckets, or null if rateLimit is 0
+        std::unique_ptr<HeavyHitters> talkers;     ///< Heaviest sources over the run, or null if topTalkers is 0
+        std::unique_ptr<HeavyHitters> windowTalkers; ///< Source counts in the current auto-block window, or null if auto-blocking is off
+        std::unique_ptr<MetricsRecorder> metrics;  ///< Per-cycle time series, or null if metricsFile is empty
+        int autoBlockWindowStart;                  ///< First cycle of the current auto-block window
+        std::unordered_set<uint32_t> autoBlocked;  ///< Sources blocked for crossing autoBlockThreshold
         Config config;                      ///< Simulation configuration parameters
         LogFile* logFile;                   ///< Pointer to the shared log file (non-owning)
 
@@ -39,12 +114,88 @@ class LoadBalancer{
         int nextServerId;    ///< ID to assign to the next server created
         int lastScaleTime;   ///< Clock cycle at which the last scaling event occurred
 
+        bool eventDriven;                   ///< True when running in "event" simulation mode
+        EventQueue events;                  ///< Pending events (event mode only)
+        int pendingScaleCheck;              ///< Cycle of the scheduled ScaleCheck event, or -1 if none
+
+        std::mt19937 rng;                   ///< Per-instance engine seeding every component below, seeded from Config::getSeed()
+        std::unique_ptr<ArrivalProcess> arrivals;           ///< Number of requests arriving on each cycle
+        std::unique_ptr<RequestGenerator> requestGenerator; ///< Source of request contents
+        std::vector<Request> arrivalBatch;  ///< Scratch buffer for the requests arriving together
+        std::vector<Request> dispatchBatch; ///< Scratch buffer for the requests started together on idle servers
+        std::vector<int> dispatchSlots;     ///< Slots that received dispatchBatch, in the same order
+        std::vector<int> arrivalCounts;     ///< Scratch per-cycle arrival counts for one epoch (parallel mode)
+        int pendingArrivals;                ///< Arrivals due at the scheduled Arrival event (event mode)
+        long long arrivalCount;             ///< Requests offered, the initial queue and blocked ones included
+        std::unique_ptr<DispatchPolicy> dispatchPolicy; ///< Chooses the server for each queued request
+        std::unique_ptr<Autoscaler> autoscaler;         ///< Decides how many servers to add or remove
+        std::unique_ptr<ShedPolicy> shedPolicy;         ///< Bounds the request queue and decides what to shed
+        RequestTimings timings;             ///< Queue waits of started requests and end-to-end times of completed ones
+        long long serverCycles;             ///< Sum over elapsed cycles of the server count
+        int serverCyclesTime;               ///< Cycle up to which serverCycles has been accumulated
+
+        std::vector<Shard> shards;          ///< Server partitions (parallel mode only, otherwise empty)
+        int nextShard;                      ///< Shard that receives the next routed request
+        std::vector<RejectedArrival> rejectedArrivals; ///< Blocked, rate limited and shed arrivals awaiting logging (parallel mode)
+        int routedQueueDepth;               ///< Shard queue depth as seen by admission control this epoch (parallel mode)
+
         /**
-         * @brief Checks whether the given IP is covered by any blocked range.
-         * @param ip IPv4 address string to test.
+         * @brief Checks whether the given IP was auto-blocked or is covered by any blocked range.
+         * @param ip IPv4 address to test.
          * @return true if the IP is blocked, false otherwise.
          */
-        bool isIpBlocked(const std::string& ip) const;
+        bool isIpBlocked(uint32_t ip) const;
+
+        /**
+         * @brief Charges a request to its source's rate limit.
+         * @param ip Source IPv4 address of the request.
+         * @param cycle Clock cycle of the arrival.
+         * @return true if the source is over its limit and the request should be rejected.
+         */
+        bool isRateLimited(uint32_t ip, int cycle);
+
+        /**
+         * @brief Counts an arrival towards its source's auto-block window, blocking the source if it crosses the threshold.
+         * @param ip Source IPv4 address of the request.
+         * @param cycle Clock cycle of the arrival.
+         * @return The source's guaranteed request count in the window if this arrival took it to the threshold
+         *         (the request should be rejected), otherwise 0.
+         */
+        uint32_t crossesAutoBlock(uint32_t ip, int cycle);
+
+        /**
+         * @brief Runs an arrival through the source filters and stamps it if it passes.
+         *
+         * The order is: heavy-hitter tracking, blocklist, auto-block, rate limit.
+         * Every arrival path goes through here, so the order cannot drift between modes.
+         *
+         * @param request The arriving request; its arrival time is set to cycle if it passes.
+         * @param cycle Clock cycle of the arrival.
+         * @param windowCount Set to the source's window count when the result is AutoBlocked.
+         * @return The filter that rejected the request, or RejectKind::None.
+         */
+        RejectKind screenArrival(Request& request, int cycle, uint32_t& windowCount);
+
+        /**
+         * @brief Writes the log line for a rejected arrival.
+         * @param rejected The rejected arrival.
+         */
+        void logRejection(const RejectedArrival& rejected);
+
+        /**
+         * @brief Logs the heaviest sources so far, if top talkers are tracked.
+         * @param cycle Clock cycle to log at.
+         */
+        void logTopTalkers(int cycle);
+
+        /**
+         * @brief Logs the latency of the requests completed since the last status and starts a new interval.
+         * @param cycle Clock cycle to log at.
+         */
+        void logLatency(int cycle);
+
+        /** @brief Records the state at the end of the current cycle, if metrics are recorded. */
+        void recordMetrics();
 
         /**
          * @brief Checks whether enough time has elapsed since the last scaling event.
@@ -53,39 +204,164 @@ class LoadBalancer{
         bool canScaleUp() const;
 
         /**
-         * @brief Evaluates queue depth against thresholds and triggers scale-up or scale-down.
+         * @brief Checks whether at least one server in the pool is idle.
+         * @return true if an idle server exists, false otherwise.
+         */
+        bool hasIdleServer() const;
+
+        /**
+         * @brief Asks the autoscaler for a decision and adds or removes servers accordingly.
          *
-         * Does nothing if the cooldown period has not elapsed since the last scaling event.
+         * Also records the queue depth for the summary. Does nothing else if the
+         * cooldown period has not elapsed since the last scaling event.
+         * In event mode a ScaleCheck event is scheduled for the end of the cooldown so a
+         * pending threshold crossing is not missed while the clock skips ahead.
          */
         void checkAndScale();
 
         /**
-         * @brief Allocates a new WebServer, adds it to the pool, and logs the event.
+         * @brief Adds the server count times the cycles elapsed since the last call to serverCycles.
+         *
+         * Called before every change in server count and at the end of the run.
+         */
+        void accountServerCycles();
+
+        /**
+         * @brief Adds a new server to the pool, and logs the event.
          */
         void addServer();
 
         /**
-         * @brief Removes the first idle server from the pool and logs the event.
+         * @brief Removes an idle server from the pool and logs the event.
          * @return true if a server was successfully removed, false if none are idle or only one server remains.
          */
         bool removeServer();
 
         /**
-         * @brief Assigns queued requests to idle servers.
+         * @brief Filters blocked requests out of a batch, stamps the rest and queues them.
+         * @param batch Requests arriving on the current cycle; compacted in place.
+         * @param count Number of requests in batch.
+         */
+        void admitBatch(Request* batch, int count);
+
+        /**
+         * @brief Queues one stamped request, subject to the shed policy.
+         * @param request Request to queue.
+         * @return true if the request was queued, false if it was shed.
+         */
+        bool admitRequest(const Request& request);
+
+        /**
+         * @brief Stamps one arrival and routes it to the next shard, or records it as blocked or shed (parallel mode).
+         * @param cycle Arrival cycle.
+         * @param request The arriving request.
+         */
+        void routeArrival(int cycle, Request& request);
+
+        /**
+         * @brief Returns the shard with the most queued requests (parallel mode).
+         * @return Shard index, or -1 if every shard queue is empty.
+         */
+        int longestShardQueue() const;
+
+        /**
+         * @brief Moves the requests submitted through submit() into the simulation.
          *
-         * Iterates over the server pool and dequeues one request per idle server.
+         * Drains at most one queue's capacity per call so busy producers
+         * cannot hold the simulation on one cycle. In parallel mode the
+         * requests are routed to the shards as arrivals on the current cycle.
+         */
+        void drainIngress();
+
+        /**
+         * @brief Hands queued requests to servers until the dispatch policy finds no room.
          */
         void distributeRequests();
 
         /**
-         * @brief Advances all busy servers by one clock cycle and logs completed requests.
+         * @brief Logs a request that started processing and records its queue wait.
+         * @param serverId ID of the server processing the request.
+         * @param request The request that started.
+         * @param cycle Clock cycle on which it started.
+         */
+        void requestStarted(int serverId, const Request& request, int cycle);
+
+        /**
+         * @brief Logs a finished request and starts the server's next local request or idles it.
+         * @param slot Pool slot of the server that finished.
+         */
+        void completeRequest(int slot);
+
+        /**
+         * @brief Logs and releases every server whose request completes at the current cycle.
+         *
+         * The tick loop advances the whole pool with one vectorized pass; the event
+         * loop pops due completions from the pool's completion heap.
          */
         void processServers();
 
         /**
-         * @brief Randomly generates and enqueues a new request based on the configured probability.
+         * @brief Generates a batch of arriving requests and queues the unblocked ones in one call.
+         * @param count Number of requests arriving on the current cycle.
+         */
+        void addArrivals(int count);
+
+        /**
+         * @brief Runs the per-cycle simulation loop, visiting every clock cycle.
+         * @param totalRunTime Number of clock cycles to simulate.
+         * @param statusInterval Number of cycles between status snapshots.
+         */
+        void runTicks(int totalRunTime, int statusInterval);
+
+        /**
+         * @brief Runs the event-driven simulation loop, jumping between scheduled events.
+         * @param totalRunTime Number of clock cycles to simulate.
+         * @param statusInterval Number of cycles between status snapshots.
+         */
+        void runEvents(int totalRunTime, int statusInterval);
+
+        /**
+         * @brief Runs the sharded multi-threaded simulation loop.
+         * @param totalRunTime Number of clock cycles to simulate.
+         * @param statusInterval Number of cycles between status snapshots.
+         */
+        void runParallel(int totalRunTime, int statusInterval);
+
+        /**
+         * @brief Writes the log entries recorded by the shards during an epoch.
+         *
+         * For each cycle the order is: blocked arrivals, completions by shard, starts by shard.
+         *
+         * @param fromTime First cycle of the epoch.
+         * @param toTime One past the last cycle of the epoch.
+         */
+        void flushShardLogs(int fromTime, int toTime);
+
+        /**
+         * @brief Moves queued requests from shards with a backlog to shards with idle servers.
+         *
+         * Runs on the coordinating thread while the workers wait at the barrier, so
+         * the outcome depends only on shard state and is deterministic.
+         */
+        void balanceShards();
+
+        /**
+         * @brief Schedules the next cycle with arrivals at or after the given cycle.
+         *
+         * The ArrivalProcess skips empty cycles (in one geometric draw for
+         * bernoulli arrivals) and the count is kept in pendingArrivals.
+         *
+         * @param fromTime First cycle on which the arrival may occur.
+         */
+        void scheduleNextArrival(int fromTime);
+
+        /**
+         * @brief Returns the next cycle on which an event or a request completion is due.
+         *
+         * Pending ingress requests make the next cycle due, so submitted requests are never held back.
+         * @return Next event cycle, or -1 if nothing is scheduled.
          */
-        void addNewRequest();
+        int nextEventTime() const;
 
     public:
         /**
@@ -95,11 +371,6 @@ class LoadBalancer{
          */
         LoadBalancer(const Config& config, LogFile* logFile);
 
-        /**
-         * @brief Destructor. Frees all dynamically allocated WebServer objects.
-         */
-        ~LoadBalancer();
-
         /**
          * @brief Creates the initial server pool and seeds the request queue.
          *
@@ -112,19 +383,42 @@ class LoadBalancer{
          * @brief Runs the main simulation loop for the configured number of clock cycles.
          *
          * Each cycle: generates requests, processes servers, distributes work, and checks scaling.
-         * Logs a status snapshot every totalRunTime/20 cycles.
+         * Logs a status snapshot every totalRunTime/20 cycles. In event mode only the cycles
+         * on which an event fires are visited.
          */
         void run();
 
         /**
          * @brief Submits a request to the queue, blocking it if the source IP is filtered.
+         *
+         * Subject to the shed policy and counted in the metrics like any other
+         * arrival. It does not feed the autoscaler's arrival rate, since it is
+         * how init() seeds the initial queue all at once.
+         *
          * @param request The Request to add.
-         * @return true if the request was enqueued, false if it was blocked.
+         * @return true if the request was enqueued, false if it was blocked or shed.
          */
         bool addRequest(const Request& request);
 
         /**
-         * @brief Returns the current number of requests waiting in the queue.
+         * @brief Hands a request to the simulation from any thread.
+         *
+         * The request waits in a lock-free queue and joins the simulation
+         * (IP filtering, arrival stamp, queueing) when the simulation thread
+         * next drains it: at the start of the next cycle in tick mode, the
+         * next visited cycle in event mode, or the next epoch in parallel mode.
+         *
+         * @param request The Request to submit.
+         * @return true if the request was accepted, false if the ingress queue is full.
+         */
+        bool submit(const Request& request);
+
+        /**
+         * @brief Returns the current number of requests waiting to start.
+         *
+         * Includes requests held in the servers' local queues and an
+         * approximate count of submitted requests not yet drained.
+         *
          * @return Queue size.
          */
         int getQueueSize() const;
@@ -140,6 +434,18 @@ class LoadBalancer{
          * @return Current time.
          */
         int getCurrTime() const;
+
+        /**
+         * @brief Returns the queue waits of every request that started processing.
+         * @return Wait distribution.
+         */
+        const WaitStats& getWaitStats() const;
+
+        /**
+         * @brief Returns the capacity used so far, as servers times cycles.
+         * @return Server-cycles accumulated up to the last scaling event or the end of the run.
+         */
+        long long getServerCycles() const;
 };
 
 
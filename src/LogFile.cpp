@@ -4,217 +4,675 @@
  */
 
 #include "LogFile.h"
+#include "IpRange.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <iomanip>
+#include <sstream>
+#include <utility>
+
+namespace {
+
+/// Records the writer thread takes from the ring at a time.
+const size_t writerBatch = 256;
+
+/// Longest the idle writer thread sleeps before checking the ring again.
+const std::chrono::milliseconds writerPoll(1);
+
+/// Appends the "[Cycle 00042] " prefix.
+void appendCycle(std::string& out, int cycle) {
+    std::string digits = std::to_string(cycle);
+    out += "[Cycle ";
+    if (digits.size() < 5) {
+        out.append(5 - digits.size(), '0');
+    }
+    out += digits;
+    out += "] ";
+}
+
+/// Returns the console color of a record type's lines.
+const char* lineColor(LogEventType type) {
+    switch (type) {
+        case LogEventType::ServerAdded:
+            return GREEN;
+        case LogEventType::ServerRemoved:
+        case LogEventType::RequestBlocked:
+        case LogEventType::SourceAutoBlocked:
+            return RED;
+        case LogEventType::RequestStarted:
+            return BLUE;
+        case LogEventType::RequestProcessed:
+        case LogEventType::TopTalkers:
+        case LogEventType::Latency:
+            return CYAN;
+        case LogEventType::RequestShed:
+            return YELLOW;
+        case LogEventType::RequestRateLimited:
+        case LogEventType::Status:
+            return MAGENTA;
+        default:
+            return WHITE;
+    }
+}
+
+/// Returns whether a record's free text travels in the pending-text queue.
+bool carriesText(const LogRecord& record) {
+    return record.type == LogEventType::Event || record.type == LogEventType::TopTalkers ||
+           record.type == LogEventType::Text || record.type == LogEventType::Latency ||
+           (record.type == LogEventType::RequestShed && record.value < 0);
+}
+
+/// Returns "p50/p90/p99/p99.9/max" of a histogram.
+std::string percentiles(const WaitStats& stats) {
+    return std::to_string(stats.getPercentile(0.50)) + "/" + std::to_string(stats.getPercentile(0.90)) + "/" +
+           std::to_string(stats.getPercentile(0.99)) + "/" + std::to_string(stats.getPercentile(0.999)) + "/" +
+           std::to_string(stats.getMax());
+}
+
+/// Servers listed in the summary's slowest-servers table.
+const int reportedServers = 10;
+
+/// Writes one row of the summary wait and latency table.
+void writeLatencyRow(std::ostream& out, const std::string& label, const WaitStats& stats) {
+    out << "  " << std::left << std::setw(18) << label << std::right << std::setw(10) << stats.getCount()
+        << std::setw(8) << stats.getPercentile(0.50) << std::setw(8) << stats.getPercentile(0.90)
+        << std::setw(8) << stats.getPercentile(0.99) << std::setw(8) << stats.getPercentile(0.999)
+        << std::setw(8) << stats.getMax() << std::endl;
+}
+
+/// Writes the summary's wait and latency section, then the slowest servers.
+void writeLatencySections(std::ostream& out, const RequestTimings& timings, const std::string& dispatchPolicy,
+                          const char* headingStart, const char* headingEnd) {
+    out << headingStart << "QUEUE WAIT AND LATENCY STATISTICS (cycles):" << headingEnd << std::endl;
+    out << "  Dispatch Policy:             " << dispatchPolicy << std::endl;
+    out << "  Mean Wait:                   " << std::fixed << std::setprecision(2) << timings.getWaits().getMean() << std::endl;
+    out << "  Mean Total:                  " << timings.getLatencies().getMean() << std::endl;
+    out << "  Wait rows count started requests, Total rows completed ones:" << std::endl;
+    out << "  " << std::string(18, ' ') << "  Requests     p50     p90     p99   p99.9     Max" << std::endl;
+    writeLatencyRow(out, "Wait   all", timings.getWaits());
+    writeLatencyRow(out, "Wait   P", timings.getWaits('P'));
+    writeLatencyRow(out, "Wait   S", timings.getWaits('S'));
+    writeLatencyRow(out, "Total  all", timings.getLatencies());
+    writeLatencyRow(out, "Total  P", timings.getLatencies('P'));
+    writeLatencyRow(out, "Total  S", timings.getLatencies('S'));
+    out << std::endl;
+
+    std::vector<ServerTimings> slowest = timings.getSlowestServers(reportedServers);
+    if (slowest.empty()) {
+        return;
+    }
+    out << headingStart << "SLOWEST SERVERS (by mean total, cycles):" << headingEnd << std::endl;
+    out << "  Server      Requests   Mean Wait  Mean Total    Max Wait   Max Total" << std::endl;
+    for (const ServerTimings& server : slowest) {
+        out << "  " << std::left << std::setw(8) << server.serverId << std::right << std::setw(12) << server.requests
+            << std::setw(12) << static_cast<double>(server.waitSum) / server.requests
+            << std::setw(12) << static_cast<double>(server.totalSum) / server.requests
+            << std::setw(12) << server.maxWait << std::setw(12) << server.maxTotal << std::endl;
+    }
+    out << std::endl;
+}
+
+}
+
+LogFile::LogFile(const std::string& filename, bool enableConsole, bool binary)
+    : filename(filename), serversCreated(0), serversDeleted(0),
+      requestsProcessed(0), requestsBlocked(0), requestsShed(0), requestsRateLimited(0), sourcesAutoBlocked(0), peakQueueDepth(0), peakQueueCycle(0), drainCycle(-1),
+      consoleOutput(enableConsole), writerStop(false), writerIdle(false), dropWhenFull(false), recordsDropped(0),
+      enabledCategories(31), sampleRate(1), sampleThreshold(UINT32_MAX) {
+
+    outFile.open(filename, binary ? std::ios::out | std::ios::binary : std::ios::out);
 
-LogFile::LogFile(const std::string& filename, bool enableConsole) 
-    : filename(filename), serversCreated(0), serversDeleted(0), 
-      requestsProcessed(0), requestsBlocked(0), consoleOutput(enableConsole) {
-    
-    outFile.open(filename);
-    
     if (!outFile.is_open()) {
         std::cerr << RED << "Error: Could not open log file '" << filename << "'" << RESET << std::endl;
+    } else if (binary) {
+        binaryLog.reset(new BinaryLog());
+        outFile.write(BinaryLog::magic, sizeof(BinaryLog::magic));
     }
 }
 
+LogFile::LogFile()
+    : serversCreated(0), serversDeleted(0), requestsProcessed(0), requestsBlocked(0), requestsShed(0), requestsRateLimited(0), sourcesAutoBlocked(0),
+      peakQueueDepth(0), peakQueueCycle(0), drainCycle(-1), consoleOutput(false), writerStop(false), writerIdle(false),
+      dropWhenFull(false), recordsDropped(0), enabledCategories(31), sampleRate(1), sampleThreshold(UINT32_MAX) {
+}
+
 LogFile::~LogFile() {
-    if (outFile.is_open()) {
-        outFile.close();
+    close();
+}
+
+void LogFile::startAsync(int bufferSize, bool dropWhenFull) {
+    if (ring || !hasOutput()) {
+        return;
     }
+    this->dropWhenFull = dropWhenFull;
+    shedReasons.reserve(maxShedReasons);
+    ring.reset(new LogRing(bufferSize));
+    writerStop = false;
+    writer = std::thread(&LogFile::writerLoop, this);
+}
+
+void LogFile::startDashboard(int refreshRate, int totalRunTime) {
+    consoleOutput = false;
+    dashboard.reset(new Dashboard(refreshRate, totalRunTime));
+}
+
+bool LogFile::hasOutput() const {
+    return outFile.is_open() || consoleOutput || dashboard;
+}
+
+bool LogFile::parseCategories(const std::string& list, unsigned& mask) {
+    static const std::pair<const char*, LogCategory> names[] = {
+        {"requests", LogCategory::Requests}, {"rejections", LogCategory::Rejections},
+        {"scaling", LogCategory::Scaling}, {"status", LogCategory::Status}, {"events", LogCategory::Events}
+    };
+
+    mask = 0;
+    std::stringstream ss(list);
+    std::string name;
+    while (std::getline(ss, name, ',')) {
+        if (name == "all") {
+            mask = 31;
+            continue;
+        }
+        bool known = false;
+        for (const auto& entry : names) {
+            if (name == entry.first) {
+                mask |= static_cast<unsigned>(entry.second);
+                known = true;
+            }
+        }
+        if (!known) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LogFile::setCategories(unsigned mask) {
+    enabledCategories = mask;
+}
+
+void LogFile::setSampleRate(int rate) {
+    sampleRate = std::max(rate, 1);
+    sampleThreshold = sampleRate == 1 ? UINT32_MAX : static_cast<uint32_t>((1ULL << 32) / sampleRate);
 }
 
 void LogFile::setConsoleOutput(bool enable) {
     consoleOutput = enable;
 }
 
-void LogFile::logHeader(int initServers, int runTime, int minProcessTime, int maxProcessTime,
-                        int startingQueueSize, const std::string& ipRangeStart, const std::string& ipRangeEnd) {
-    std::string separator = "================================================================================";
+void LogFile::emit(const LogRecord& record, const std::string* text, const std::string* consoleText) {
+    if (dashboard && record.type == LogEventType::Text) {
+        // the header and summary follow the run, so the final frame goes above them
+        dashboard->finish();
+    }
+    if (!ring) {
+        if (hasOutput()) {
+            format(record, text, consoleText);
+            writeBuffers(false);
+        }
+        return;
+    }
+    if (!carriesText(record)) {
+        enqueue(record, dropWhenFull);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(textMutex);
+        pendingText.push_back(*text);
+        if (record.type == LogEventType::Text) {
+            pendingText.push_back(*consoleText);
+        }
+    }
+    // the writer pops the text when it reaches the record, so the record must not be lost
+    enqueue(record, false);
+}
 
-    if (outFile.is_open()) {
-        outFile << separator << std::endl;
-        outFile << "                        LOAD BALANCER STARTING STATS" << std::endl;
-        outFile << separator << std::endl;
-        outFile << std::endl;
-        outFile << "INITIAL CONFIGURATION:" << std::endl;
-        outFile << "  Starting Number of Servers:  " << initServers << std::endl;
-        outFile << "  Starting Queue Size:         " << startingQueueSize << std::endl;
-        outFile << "  Total Run Time:              " << runTime << " clock cycles" << std::endl;
-        outFile << "  Task Time Range:             " << minProcessTime << " - " << maxProcessTime << " clock cycles" << std::endl;
-        outFile << "  Blocked IP Range Start:      " << ipRangeStart << std::endl;
-        outFile << "  Blocked IP Range End:        " << ipRangeEnd << std::endl;
-        outFile << std::endl;
-    }
-
-    if (consoleOutput) {
-        std::cout << BOLD << BLUE << separator << RESET << std::endl;
-        std::cout << BOLD << BLUE << "                        LOAD BALANCER STARTING STATS" << RESET << std::endl;
-        std::cout << BOLD << BLUE << separator << RESET << std::endl;
-        std::cout << std::endl;
-        std::cout << BOLD << WHITE << "INITIAL CONFIGURATION:" << RESET << std::endl;
-        std::cout << "  Starting Number of Servers:  " << GREEN << initServers << RESET << std::endl;
-        std::cout << "  Starting Queue Size:         " << GREEN << startingQueueSize << RESET << std::endl;
-        std::cout << "  Total Run Time:              " << GREEN << runTime << " clock cycles" << RESET << std::endl;
-        std::cout << "  Task Time Range:             " << GREEN << minProcessTime << " - " << maxProcessTime << " clock cycles" << RESET << std::endl;
-        std::cout << "  Blocked IP Range Start:      " << CYAN << ipRangeStart << RESET << std::endl;
-        std::cout << "  Blocked IP Range End:        " << CYAN << ipRangeEnd << RESET << std::endl;
-        std::cout << std::endl;
-    }
-}
-
-
-void LogFile::logEvent(int cycle, const std::string& message) {
-    if (outFile.is_open()) {
-        outFile << "[Cycle " << std::setw(5) << std::setfill('0') << cycle << "] " 
-                << message << std::endl;
+void LogFile::enqueue(const LogRecord& record, bool mayDrop) {
+    while (!ring->tryPush(record)) {
+        if (mayDrop) {
+            recordsDropped++;
+            return;
+        }
+        wakeWriter();
+        std::this_thread::yield();
     }
+    if (writerIdle.load(std::memory_order_relaxed) && ring->sizeApprox() >= ring->capacity() / 2) {
+        wakeWriter();
+    }
+}
 
-    if (consoleOutput) {
-        std::cout << WHITE << "[Cycle " << std::setw(5) << std::setfill('0') << cycle << "] " 
-                  << message << RESET << std::endl;
+void LogFile::wakeWriter() {
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
     }
+    writerWake.notify_one();
 }
 
+int LogFile::internShedReason(const std::string& reason) {
+    for (size_t i = 0; i < shedReasons.size(); i++) {
+        if (shedReasons[i] == reason) {
+            return i;
+        }
+    }
+    if (shedReasons.size() == maxShedReasons) {
+        return -1;
+    }
+    shedReasons.push_back(reason);
+    return shedReasons.size() - 1;
+}
 
-void LogFile::logServerAdded(int cycle, int serverId) {
-    serversCreated++;
-    
-    if (outFile.is_open()) {
-        outFile << "[Cycle " << std::setw(5) << std::setfill('0') << cycle << "] "
-                << "ADDED: Server " << serverId << " created" << std::endl;
+void LogFile::format(const LogRecord& record, const std::string* text, const std::string* consoleText) {
+    bool toFile = outFile.is_open();
+    bool toConsole = consoleOutput;
+    const std::string* detail = record.type == LogEventType::RequestShed && record.value >= 0 ? &shedReasons[record.value] : text;
+
+    if (toFile && binaryLog) {
+        binaryLog->append(record, detail ? *detail : std::string());
+        toFile = false;
+    }
+
+    if (record.type == LogEventType::Text) {
+        if (toFile) {
+            fileBuffer += *text;
+        }
+        if (toConsole || dashboard) {
+            consoleBuffer += *consoleText;
+        }
+        return;
+    }
+
+    if (!toFile && !toConsole) {
+        return;
     }
+    lineBuffer.clear();
+    formatLine(lineBuffer, record, detail);
 
-    if (consoleOutput) {
-        std::cout << GREEN << "[Cycle " << std::setw(5) << std::setfill('0') << cycle << "] "
-                  << "ADDED: Server " << serverId << " created" << RESET << std::endl;
+    if (toFile) {
+        fileBuffer += lineBuffer;
+        fileBuffer += '\n';
+    }
+    if (toConsole) {
+        consoleBuffer += lineColor(record.type);
+        consoleBuffer += lineBuffer;
+        consoleBuffer += RESET;
+        consoleBuffer += '\n';
     }
 }
 
-void LogFile::logServerRemoved(int cycle, int serverId) {
-    serversDeleted++;
-    
-    if (outFile.is_open()) {
-        outFile << "[Cycle " << std::setw(5) << std::setfill('0') << cycle << "] "
-                << "REMOVED: Server " << serverId << " deallocated" << std::endl;
+void LogFile::formatLine(std::string& line, const LogRecord& record, const std::string* text) {
+    appendCycle(line, record.cycle);
+    switch (record.type) {
+        case LogEventType::Event:
+            line += *text;
+            break;
+        case LogEventType::ServerAdded:
+            line += "ADDED: Server " + std::to_string(record.number) + " created";
+            break;
+        case LogEventType::ServerRemoved:
+            line += "REMOVED: Server " + std::to_string(record.number) + " deallocated";
+            break;
+        case LogEventType::RequestStarted:
+            line += "STARTED: Server " + std::to_string(record.number) + " processing request ";
+            line += IpRange::toString(record.ipIn) + " -> " + IpRange::toString(record.ipOut);
+            line += " (Time: " + std::to_string(record.value) + " cycles)";
+            break;
+        case LogEventType::RequestProcessed:
+            line += "COMPLETE: Server " + std::to_string(record.number) + " finished request ";
+            line += IpRange::toString(record.ipIn) + " -> " + IpRange::toString(record.ipOut);
+            line += " (Time taken: " + std::to_string(record.value) + " cycles)";
+            break;
+        case LogEventType::RequestBlocked:
+            line += "BLOCKED: Request from " + IpRange::toString(record.ipIn) + " rejected (IP in blocked range)";
+            break;
+        case LogEventType::RequestShed:
+            line += "SHED: Request from " + IpRange::toString(record.ipIn) + " dropped (";
+            line += *text;
+            line += ")";
+            break;
+        case LogEventType::RequestRateLimited:
+            line += "LIMITED: Request from " + IpRange::toString(record.ipIn) + " rejected (source over rate limit)";
+            break;
+        case LogEventType::SourceAutoBlocked:
+            line += "AUTOBLOCK: Source " + IpRange::toString(record.ipIn) + " blocked (" + std::to_string(record.value);
+            line += " requests within " + std::to_string(record.number) + " cycles)";
+            break;
+        case LogEventType::TopTalkers:
+            line += "TOP TALKERS: " + *text;
+            break;
+        case LogEventType::Status:
+            line += "STATUS: Queue size: " + std::to_string(record.value);
+            line += " | Active servers: " + std::to_string(record.number);
+            break;
+        case LogEventType::Latency:
+            line += "LATENCY: " + *text;
+            break;
+        case LogEventType::Text:
+            break;
     }
+}
 
-    if (consoleOutput) {
-        std::cout << RED << "[Cycle " << std::setw(5) << std::setfill('0') << cycle << "] "
-                  << "REMOVED: Server " << serverId << " deallocated" << RESET << std::endl;
+void LogFile::writeBuffers(bool endBlock) {
+    if (binaryLog && (endBlock || binaryLog->size() >= chunkBytes)) {
+        binaryLog->finishBlock(fileBuffer);
+    }
+    if (!fileBuffer.empty()) {
+        outFile.write(fileBuffer.data(), fileBuffer.size());
+        outFile.flush();
+        fileBuffer.clear();
+    }
+    if (!consoleBuffer.empty()) {
+        std::cout.write(consoleBuffer.data(), consoleBuffer.size());
+        std::cout.flush();
+        consoleBuffer.clear();
     }
 }
 
-void LogFile::logRequestStarted(int cycle, int serverId, const std::string& ipIn, const std::string& ipOut, int processTime) {
-    if (outFile.is_open()) {
-        outFile << "[Cycle " << std::setw(5) << std::setfill('0') << cycle << "] "
-                << "STARTED: Server " << serverId << " processing request " 
-                << ipIn << " -> " << ipOut << " (Time: " << processTime << " cycles)" << std::endl;
+void LogFile::writerLoop() {
+    std::vector<LogRecord> batch(writerBatch);
+    std::string text;
+    std::string consoleText;
+    while (true) {
+        size_t count = ring->popBatch(batch.data(), batch.size());
+        if (count > 0) {
+            for (size_t i = 0; i < count; i++) {
+                const LogRecord& record = batch[i];
+                if (carriesText(record)) {
+                    std::lock_guard<std::mutex> lock(textMutex);
+                    text = std::move(pendingText.front());
+                    pendingText.pop_front();
+                    if (record.type == LogEventType::Text) {
+                        consoleText = std::move(pendingText.front());
+                        pendingText.pop_front();
+                    }
+                }
+                format(record, &text, &consoleText);
+            }
+            if (fileBuffer.size() >= chunkBytes || consoleBuffer.size() >= chunkBytes ||
+                (binaryLog && binaryLog->size() >= chunkBytes)) {
+                writeBuffers(false);
+            }
+            continue;
+        }
+
+        // caught up: write what is buffered, then sleep until more arrives
+        writeBuffers(true);
+        std::unique_lock<std::mutex> lock(writerMutex);
+        if (writerStop) {
+            // close() takes the lock after the last push, so an empty ring here stays empty
+            if (ring->sizeApprox() == 0) {
+                break;
+            }
+            continue;
+        }
+        writerIdle.store(true, std::memory_order_relaxed);
+        writerWake.wait_for(lock, writerPoll);
+        writerIdle.store(false, std::memory_order_relaxed);
     }
+}
 
-    if (consoleOutput) {
-        std::cout << BLUE << "[Cycle " << std::setw(5) << std::setfill('0') << cycle << "] "
-                  << "STARTED: Server " << serverId << " processing request " 
-                  << ipIn << " -> " << ipOut << " (Time: " << processTime << " cycles)" << RESET << std::endl;
+void LogFile::logHeader(int initServers, int runTime, int minProcessTime, int maxProcessTime,
+                        int startingQueueSize, const std::string& ipRangeStart, const std::string& ipRangeEnd) {
+    if (!hasOutput()) {
+        return;
     }
+
+    std::string separator = "================================================================================";
+    std::ostringstream fileText;
+    std::ostringstream consoleText;
+
+    fileText << separator << std::endl;
+    fileText << "                        LOAD BALANCER STARTING STATS" << std::endl;
+    fileText << separator << std::endl;
+    fileText << std::endl;
+    fileText << "INITIAL CONFIGURATION:" << std::endl;
+    fileText << "  Starting Number of Servers:  " << initServers << std::endl;
+    fileText << "  Starting Queue Size:         " << startingQueueSize << std::endl;
+    fileText << "  Total Run Time:              " << runTime << " clock cycles" << std::endl;
+    fileText << "  Task Time Range:             " << minProcessTime << " - " << maxProcessTime << " clock cycles" << std::endl;
+    fileText << "  Blocked IP Range Start:      " << ipRangeStart << std::endl;
+    fileText << "  Blocked IP Range End:        " << ipRangeEnd << std::endl;
+    fileText << std::endl;
+
+    consoleText << BOLD << BLUE << separator << RESET << std::endl;
+    consoleText << BOLD << BLUE << "                        LOAD BALANCER STARTING STATS" << RESET << std::endl;
+    consoleText << BOLD << BLUE << separator << RESET << std::endl;
+    consoleText << std::endl;
+    consoleText << BOLD << WHITE << "INITIAL CONFIGURATION:" << RESET << std::endl;
+    consoleText << "  Starting Number of Servers:  " << GREEN << initServers << RESET << std::endl;
+    consoleText << "  Starting Queue Size:         " << GREEN << startingQueueSize << RESET << std::endl;
+    consoleText << "  Total Run Time:              " << GREEN << runTime << " clock cycles" << RESET << std::endl;
+    consoleText << "  Task Time Range:             " << GREEN << minProcessTime << " - " << maxProcessTime << " clock cycles" << RESET << std::endl;
+    consoleText << "  Blocked IP Range Start:      " << CYAN << ipRangeStart << RESET << std::endl;
+    consoleText << "  Blocked IP Range End:        " << CYAN << ipRangeEnd << RESET << std::endl;
+    consoleText << std::endl;
+
+    std::string file = fileText.str();
+    std::string console = consoleText.str();
+    emit(LogRecord{0, LogEventType::Text, 0, 0, 0, 0}, &file, &console);
 }
 
-void LogFile::logRequestProcessed(int cycle, int serverId, const std::string& ipIn, const std::string& ipOut, int processTime) {
-    requestsProcessed++;
-    
-    if (outFile.is_open()) {
-        outFile << "[Cycle " << std::setw(5) << std::setfill('0') << cycle << "] "
-                << "COMPLETE: Server " << serverId << " finished request " 
-                << ipIn << " -> " << ipOut << " (Time taken: " << processTime << " cycles)" << std::endl;
+
+void LogFile::logEvent(int cycle, const std::string& message, LogCategory category) {
+    if (!wants(category)) {
+        return;
+    }
+    emit(LogRecord{cycle, LogEventType::Event, 0, 0, 0, 0}, &message);
+}
+
+
+void LogFile::logServerAdded(int cycle, int serverId) {
+    serversCreated++;
+    if (!wants(LogCategory::Scaling)) {
+        return;
+    }
+    emit(LogRecord{cycle, LogEventType::ServerAdded, serverId, 0, 0, 0});
+}
+
+void LogFile::logServerRemoved(int cycle, int serverId) {
+    serversDeleted++;
+    if (!wants(LogCategory::Scaling)) {
+        return;
     }
+    emit(LogRecord{cycle, LogEventType::ServerRemoved, serverId, 0, 0, 0});
+}
 
-    if (consoleOutput) {
-        std::cout << CYAN << "[Cycle " << std::setw(5) << std::setfill('0') << cycle << "] "
-                  << "COMPLETE: Server " << serverId << " finished request " 
-                  << ipIn << " -> " << ipOut << " (Time taken: " << processTime << " cycles)" << RESET << std::endl;
+void LogFile::logRequestBlocked(int cycle, uint32_t ip) {
+    requestsBlocked++;
+    if (!wants(LogCategory::Rejections) || !sampled(ip, 0)) {
+        return;
     }
+    emit(LogRecord{cycle, LogEventType::RequestBlocked, 0, ip, 0, 0});
 }
 
+void LogFile::logRequestShed(int cycle, uint32_t ip, const std::string& reason) {
+    requestsShed++;
+    if (!wants(LogCategory::Rejections) || !sampled(ip, 0)) {
+        return;
+    }
+    int interned = ring ? internShedReason(reason) : -1;
+    emit(LogRecord{cycle, LogEventType::RequestShed, 0, ip, 0, interned}, &reason);
+}
 
+void LogFile::logRequestRateLimited(int cycle, uint32_t ip) {
+    requestsRateLimited++;
+    if (!wants(LogCategory::Rejections) || !sampled(ip, 0)) {
+        return;
+    }
+    emit(LogRecord{cycle, LogEventType::RequestRateLimited, 0, ip, 0, 0});
+}
 
-void LogFile::logRequestBlocked(int cycle, const std::string& ip) {
+void LogFile::logSourceAutoBlocked(int cycle, uint32_t ip, int count, int window) {
     requestsBlocked++;
+    sourcesAutoBlocked++;
+    if (!wants(LogCategory::Rejections)) {
+        return;
+    }
+    emit(LogRecord{cycle, LogEventType::SourceAutoBlocked, window, ip, 0, count});
+}
 
-    if (outFile.is_open()) {
-        outFile << "[Cycle " << std::setw(5) << std::setfill('0') << cycle << "] "
-                << "BLOCKED: Request from " << ip << " rejected (IP in blocked range)" << std::endl;
+void LogFile::logTopTalkers(int cycle, const std::vector<Talker>& talkers) {
+    if (!wants(LogCategory::Status) || !hasOutput()) {
+        return;
     }
 
-    if (consoleOutput) {
-        std::cout << RED << "[Cycle " << std::setw(5) << std::setfill('0') << cycle << "] "
-                  << "BLOCKED: Request from " << ip << " rejected (IP in blocked range)" << RESET << std::endl;
+    std::string list;
+    for (const Talker& talker : talkers) {
+        list += (list.empty() ? "" : ", ") + IpRange::toString(talker.ip) + " (" + std::to_string(talker.estimate) + ")";
     }
+    emit(LogRecord{cycle, LogEventType::TopTalkers, 0, 0, 0, 0}, &list);
 }
 
 void LogFile::logStatus(int cycle, int queueSize, int serverCount) {
-    if (outFile.is_open()) {
-        outFile << "[Cycle " << std::setw(5) << std::setfill('0') << cycle << "] "
-                << "STATUS: Queue size: " << queueSize 
-                << " | Active servers: " << serverCount << std::endl;
+    if (!wants(LogCategory::Status)) {
+        return;
+    }
+    emit(LogRecord{cycle, LogEventType::Status, serverCount, 0, 0, queueSize});
+}
+
+void LogFile::logLatency(int cycle, const WaitStats& waits, const WaitStats& latencies) {
+    if (!wants(LogCategory::Status) || !hasOutput() || latencies.getCount() == 0) {
+        return;
     }
 
-    if (consoleOutput) {
-        std::cout << MAGENTA << "[Cycle " << std::setw(5) << std::setfill('0') << cycle << "] "
-                  << "STATUS: Queue size: " << queueSize 
-                  << " | Active servers: " << serverCount << RESET << std::endl;
+    std::string text = "p50/p90/p99/p99.9/max wait " + percentiles(waits) + " | total " + percentiles(latencies) +
+                       " (" + std::to_string(latencies.getCount()) + " completed)";
+    emit(LogRecord{cycle, LogEventType::Latency, 0, 0, 0, 0}, &text);
+}
+
+void LogFile::recordQueueDepth(int cycle, int queueSize) {
+    if (queueSize > peakQueueDepth) {
+        peakQueueDepth = queueSize;
+        peakQueueCycle = cycle;
+        drainCycle = -1;
+    } else if (queueSize == 0 && drainCycle < 0 && peakQueueDepth > 0) {
+        drainCycle = cycle;
+    }
+    if (dashboard) {
+        dashboard->update(cycle, queueSize, serversCreated - serversDeleted, requestsProcessed, requestsBlocked,
+                          requestsShed + requestsRateLimited);
     }
 }
 
-void LogFile::writeSummary(int totalTime, int finalServerCount, int finalQueueSize) {
+void LogFile::writeSummary(int totalTime, int finalServerCount, int finalQueueSize, const std::string& autoscaler,
+                           const std::string& dispatchPolicy, const std::string& shedPolicy, const RequestTimings& timings,
+                           const std::vector<Talker>& topTalkers) {
+    if (!hasOutput()) {
+        return;
+    }
+
+    std::string drainText = "not drained";
+    if (drainCycle >= 0) {
+        drainText = std::to_string(drainCycle - peakQueueCycle) + " cycles";
+    }
+
     std::string separator = "================================================================================";
     std::string title = "                           SIMULATION SUMMARY";
-
-    if (outFile.is_open()) {
-        outFile << std::endl;
-        outFile << separator << std::endl;
-        outFile << title << std::endl;
-        outFile << separator << std::endl;
-        outFile << std::endl;
-        outFile << "RUN STATISTICS:" << std::endl;
-        outFile << "  Total Clock Cycles:          " << totalTime << std::endl;
-        outFile << "  Final Server Count:          " << finalServerCount << std::endl;
-        outFile << "  Final Queue Size:            " << finalQueueSize << std::endl;
-        outFile << std::endl;
-        outFile << "REQUEST STATISTICS:" << std::endl;
-        outFile << "  Total Requests Processed:    " << requestsProcessed << std::endl;
-        outFile << "  Total Requests Blocked:      " << requestsBlocked << std::endl;
-        outFile << std::endl;
-        outFile << "SERVER STATISTICS:" << std::endl;
-        outFile << "  Servers Created:             " << serversCreated << std::endl;
-        outFile << "  Servers Deleted:             " << serversDeleted << std::endl;
-        outFile << std::endl;
-        outFile << separator << std::endl;
-    }
-
-    if (consoleOutput) {
-        std::cout << std::endl;
-        std::cout << BOLD << BLUE << separator << RESET << std::endl;
-        std::cout << BOLD << BLUE << title << RESET << std::endl;
-        std::cout << BOLD << BLUE << separator << RESET << std::endl;
-        std::cout << std::endl;
-        std::cout << BOLD << WHITE << "RUN STATISTICS:" << RESET << std::endl;
-        std::cout << "  Total Clock Cycles:          " << totalTime << std::endl;
-        std::cout << "  Final Server Count:          " << finalServerCount << std::endl;
-        std::cout << "  Final Queue Size:            " << finalQueueSize << std::endl;
-        std::cout << std::endl;
-        std::cout << BOLD << WHITE << "REQUEST STATISTICS:" << RESET << std::endl;
-        std::cout << "  Total Requests Processed:    " << GREEN << requestsProcessed << RESET << std::endl;
-        std::cout << "  Total Requests Blocked:      " << RED << requestsBlocked << RESET << std::endl;
-        std::cout << std::endl;
-        std::cout << BOLD << WHITE << "SERVER STATISTICS:" << RESET << std::endl;
-        std::cout << "  Servers Created:             " << GREEN << serversCreated << RESET << std::endl;
-        std::cout << "  Servers Deleted:             " << RED << serversDeleted << RESET << std::endl;
-        std::cout << std::endl;
-        std::cout << BOLD << BLUE << separator << RESET << std::endl;
+    std::ostringstream fileText;
+    std::ostringstream consoleText;
+
+    fileText << std::endl;
+    fileText << separator << std::endl;
+    fileText << title << std::endl;
+    fileText << separator << std::endl;
+    fileText << std::endl;
+    fileText << "RUN STATISTICS:" << std::endl;
+    fileText << "  Total Clock Cycles:          " << totalTime << std::endl;
+    fileText << "  Final Server Count:          " << finalServerCount << std::endl;
+    fileText << "  Final Queue Size:            " << finalQueueSize << std::endl;
+    fileText << std::endl;
+    fileText << "REQUEST STATISTICS:" << std::endl;
+    fileText << "  Total Requests Processed:    " << requestsProcessed << std::endl;
+    fileText << "  Total Requests Blocked:      " << requestsBlocked << std::endl;
+    fileText << "  Total Requests Shed:         " << requestsShed << " (" << shedPolicy << ")" << std::endl;
+    fileText << "  Total Requests Rate Limited: " << requestsRateLimited << std::endl;
+    fileText << "  Sources Auto-Blocked:        " << sourcesAutoBlocked << std::endl;
+    if (ring && dropWhenFull) {
+        fileText << "  Log Entries Dropped:         " << recordsDropped << std::endl;
+    }
+    if (sampleRate > 1) {
+        fileText << "  Request Log Sampling:        1 in " << sampleRate << std::endl;
     }
+    fileText << std::endl;
+    fileText << "SERVER STATISTICS:" << std::endl;
+    fileText << "  Servers Created:             " << serversCreated << std::endl;
+    fileText << "  Servers Deleted:             " << serversDeleted << std::endl;
+    fileText << "  Autoscaler:                  " << autoscaler << std::endl;
+    fileText << "  Peak Queue Depth:            " << peakQueueDepth << " (cycle " << peakQueueCycle << ")" << std::endl;
+    fileText << "  Time to Drain From Peak:     " << drainText << std::endl;
+    fileText << std::endl;
+    writeLatencySections(fileText, timings, dispatchPolicy, "", "");
+    if (!topTalkers.empty()) {
+        fileText << "TOP TALKERS (requests, at most / at least):" << std::endl;
+        for (const Talker& talker : topTalkers) {
+            fileText << "  " << std::left << std::setw(28) << std::setfill(' ') << IpRange::toString(talker.ip) << std::right
+                     << talker.estimate << " / " << talker.guaranteed << std::endl;
+        }
+        fileText << std::endl;
+    }
+    fileText << separator << std::endl;
+
+    consoleText << std::endl;
+    consoleText << BOLD << BLUE << separator << RESET << std::endl;
+    consoleText << BOLD << BLUE << title << RESET << std::endl;
+    consoleText << BOLD << BLUE << separator << RESET << std::endl;
+    consoleText << std::endl;
+    consoleText << BOLD << WHITE << "RUN STATISTICS:" << RESET << std::endl;
+    consoleText << "  Total Clock Cycles:          " << totalTime << std::endl;
+    consoleText << "  Final Server Count:          " << finalServerCount << std::endl;
+    consoleText << "  Final Queue Size:            " << finalQueueSize << std::endl;
+    consoleText << std::endl;
+    consoleText << BOLD << WHITE << "REQUEST STATISTICS:" << RESET << std::endl;
+    consoleText << "  Total Requests Processed:    " << GREEN << requestsProcessed << RESET << std::endl;
+    consoleText << "  Total Requests Blocked:      " << RED << requestsBlocked << RESET << std::endl;
+    consoleText << "  Total Requests Shed:         " << YELLOW << requestsShed << RESET << " (" << shedPolicy << ")" << std::endl;
+    consoleText << "  Total Requests Rate Limited: " << MAGENTA << requestsRateLimited << RESET << std::endl;
+    consoleText << "  Sources Auto-Blocked:        " << RED << sourcesAutoBlocked << RESET << std::endl;
+    if (ring && dropWhenFull) {
+        consoleText << "  Log Entries Dropped:         " << YELLOW << recordsDropped << RESET << std::endl;
+    }
+    if (sampleRate > 1) {
+        consoleText << "  Request Log Sampling:        1 in " << sampleRate << std::endl;
+    }
+    consoleText << std::endl;
+    consoleText << BOLD << WHITE << "SERVER STATISTICS:" << RESET << std::endl;
+    consoleText << "  Servers Created:             " << GREEN << serversCreated << RESET << std::endl;
+    consoleText << "  Servers Deleted:             " << RED << serversDeleted << RESET << std::endl;
+    consoleText << "  Autoscaler:                  " << autoscaler << std::endl;
+    consoleText << "  Peak Queue Depth:            " << peakQueueDepth << " (cycle " << peakQueueCycle << ")" << std::endl;
+    consoleText << "  Time to Drain From Peak:     " << drainText << std::endl;
+    consoleText << std::endl;
+    writeLatencySections(consoleText, timings, dispatchPolicy, BOLD WHITE, RESET);
+    if (!topTalkers.empty()) {
+        consoleText << BOLD << WHITE << "TOP TALKERS (requests, at most / at least):" << RESET << std::endl;
+        for (const Talker& talker : topTalkers) {
+            consoleText << "  " << std::left << std::setw(28) << std::setfill(' ') << IpRange::toString(talker.ip) << std::right
+                        << talker.estimate << " / " << talker.guaranteed << std::endl;
+        }
+        consoleText << std::endl;
+    }
+    consoleText << BOLD << BLUE << separator << RESET << std::endl;
+
+    std::string file = fileText.str();
+    std::string console = consoleText.str();
+    emit(LogRecord{0, LogEventType::Text, 0, 0, 0, 0}, &file, &console);
 }
 
 void LogFile::close() {
+    if (dashboard) {
+        dashboard->finish();
+    }
+    if (ring) {
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            writerStop = true;
+        }
+        writerWake.notify_one();
+        writer.join();
+        ring.reset();
+    }
+    writeBuffers(true);
     if (outFile.is_open()) {
         outFile.close();
     }
@@ -234,4 +692,20 @@ int LogFile::getRequestsProcessed() const {
 
 int LogFile::getRequestsBlocked() const {
     return requestsBlocked;
-}
\ No newline at end of file
+}
+
+int LogFile::getRequestsShed() const {
+    return requestsShed;
+}
+
+int LogFile::getRequestsRateLimited() const {
+    return requestsRateLimited;
+}
+
+int LogFile::getSourcesAutoBlocked() const {
+    return sourcesAutoBlocked;
+}
+
+long long LogFile::getRecordsDropped() const {
+    return recordsDropped;
+}
@@ -6,8 +6,22 @@
 #ifndef LOGFILE_H
 #define LOGFILE_H
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <fstream>
+#include <thread>
+#include <vector>
+#include "BinaryLog.h"
+#include "Dashboard.h"
+#include "HeavyHitters.h"
+#include "LogRing.h"
+#include "RequestTimings.h"
+#include "WaitStats.h"
 
 /// @defgroup TerminalColors ANSI Terminal Color Codes
 /// Escape codes used to colorize console output.
@@ -15,6 +29,7 @@
 #define RESET   "\033[0m"   ///< Reset all attributes
 #define RED     "\033[31m"  ///< Red text
 #define GREEN   "\033[32m"  ///< Green text
+#define YELLOW  "\033[33m"  ///< Yellow text
 #define BLUE    "\033[34m"  ///< Blue text
 #define MAGENTA "\033[35m"  ///< Magenta text
 #define CYAN    "\033[36m"  ///< Cyan text
@@ -22,6 +37,25 @@
 #define BOLD    "\033[1m"   ///< Bold text
 /// @}
 
+/**
+ * @enum LogCategory
+ * @brief Groups of log entries that can be switched off at run time or compiled out.
+ */
+enum class LogCategory : unsigned {
+    Requests = 1,      ///< Request started and completed lines
+    Rejections = 2,    ///< Blocked, shed, rate-limited and auto-blocked requests
+    Scaling = 4,       ///< Servers added and removed, scale decisions
+    Status = 8,        ///< Status snapshots, top talkers and interval latency
+    Events = 16        ///< Initialization and run milestones
+};
+
+/// Bitmask of the LogCategory values compiled in (default: all). Entries of the
+/// other categories compile to nothing, e.g. build with
+/// CXXFLAGS+=-DLOG_COMPILED_CATEGORIES=12 to keep only scaling and status.
+#ifndef LOG_COMPILED_CATEGORIES
+#define LOG_COMPILED_CATEGORIES 31
+#endif
+
 /**
  * @class LogFile
  * @brief Writes simulation events to a log file and optionally to the console.
@@ -29,6 +63,21 @@
  * Each log entry is prefixed with a zero-padded clock cycle number. The class
  * also tracks aggregate statistics (servers created/deleted, requests
  * processed/blocked) and writes a formatted summary at the end of the simulation.
+ *
+ * Every entry is captured as a fixed-size LogRecord and formatted in one
+ * place. By default the record is formatted and written at once. After
+ * startAsync() the simulation thread only pushes the record into a LogRing
+ * and a writer thread formats the records and writes them in large chunks;
+ * the rare entries that carry free text (events, top talkers, the header
+ * and summary) pass their text through a separate mutex-guarded queue, in
+ * the same order. The counters are always updated on the calling thread,
+ * so the getters are exact in both modes. Only one thread may log.
+ *
+ * Entries can be filtered by LogCategory, and per-request entries sampled
+ * 1 in N, before any record is built; the counters still see every event.
+ * The request start and completion entries, logged once per request from
+ * the dispatch and completion loops, are defined inline below so that a
+ * disabled category costs the caller one branch rather than a call.
  */
 class LogFile {
     private:
@@ -39,21 +88,178 @@ class LogFile {
         int serversDeleted;        ///< Running count of servers removed during simulation
         int requestsProcessed;     ///< Running count of successfully completed requests
         int requestsBlocked;       ///< Running count of requests rejected due to IP blocking
-        bool consoleOutput;        ///< Whether events are also printed to stdout
+        int requestsShed;          ///< Running count of requests shed by admission control
+        int requestsRateLimited;   ///< Running count of requests rejected by per-source rate limiting
+        int sourcesAutoBlocked;    ///< Running count of sources added to the blocklist for exceeding the auto-block threshold
+        int peakQueueDepth;        ///< Largest queue depth seen by recordQueueDepth()
+        int peakQueueCycle;        ///< Cycle on which the peak queue depth was first seen
+        int drainCycle;            ///< First cycle after the peak with an empty queue, or -1
+        std::atomic<bool> consoleOutput;   ///< Whether events are also printed to stdout
+
+        static const size_t chunkBytes = 1 << 16;   ///< Formatted bytes the writer thread gathers before writing
+        static const size_t maxShedReasons = 16;    ///< Distinct shed reasons interned for async records
+
+        std::unique_ptr<BinaryLog> binaryLog;       ///< Encoder of the file side (null = text file)
+        std::unique_ptr<Dashboard> dashboard;       ///< Live console view shown instead of per-event lines (null = none)
+        std::unique_ptr<LogRing> ring;              ///< Records waiting for the writer thread (null = synchronous)
+        std::thread writer;                         ///< Writer thread, while asynchronous
+        std::mutex writerMutex;                     ///< Guards writerStop and the writer's sleep
+        std::condition_variable writerWake;         ///< Wakes the writer early when the ring fills or on close()
+        bool writerStop;                            ///< Set by close() to drain the ring and end the writer
+        std::atomic<bool> writerIdle;               ///< Whether the writer is asleep waiting for records
+        std::mutex textMutex;                       ///< Guards pendingText
+        std::deque<std::string> pendingText;        ///< Free text of queued records, in record order
+        std::vector<std::string> shedReasons;       ///< Interned shed reasons; never reallocated, so the writer may read it
+        bool dropWhenFull;                          ///< Whether a full ring drops records rather than waiting
+        long long recordsDropped;                   ///< Records dropped because the ring was full
+        unsigned enabledCategories;                 ///< Bitmask of the LogCategory values written
+        int sampleRate;                             ///< Per-request entries are kept 1 in sampleRate
+        uint32_t sampleThreshold;                   ///< Hash values below this are kept (2^32 / sampleRate)
+        std::string fileBuffer;                     ///< Formatted file text not yet written
+        std::string consoleBuffer;                  ///< Formatted console text not yet written
+        std::string lineBuffer;                     ///< Scratch space for one formatted line
+
+        /** @brief Returns whether anything is written: a file, console lines or a dashboard. */
+        bool hasOutput() const;
+
+        /**
+         * @brief Returns whether entries of a category are compiled in and enabled.
+         * @param category Category to test.
+         * @return true if its entries are written.
+         */
+        bool wants(LogCategory category) const;
+
+        /**
+         * @brief Returns whether a request's entries survive sampling.
+         *
+         * Decided by a hash of the addresses, so a kept request keeps both its
+         * start and its completion.
+         *
+         * @param ipIn Source address.
+         * @param ipOut Destination address.
+         * @return true if the entries are written.
+         */
+        bool sampled(uint32_t ipIn, uint32_t ipOut) const;
+
+        /**
+         * @brief Formats or queues one record.
+         * @param record Record to log.
+         * @param text Free text the record carries, or nullptr.
+         * @param consoleText Console version of the text of a Text record, or nullptr.
+         */
+        void emit(const LogRecord& record, const std::string* text = nullptr, const std::string* consoleText = nullptr);
+
+        /**
+         * @brief Pushes a record into the ring, waiting for space unless it may be dropped.
+         * @param record Record to push.
+         * @param mayDrop Whether the record may be discarded if the ring is full.
+         */
+        void enqueue(const LogRecord& record, bool mayDrop);
+
+        /** @brief Wakes the writer thread if it is asleep. */
+        void wakeWriter();
+
+        /**
+         * @brief Returns the index of an interned shed reason, interning it if there is room.
+         * @param reason Shed reason.
+         * @return Index into shedReasons, or -1 if the text must travel with the record.
+         */
+        int internShedReason(const std::string& reason);
+
+        /**
+         * @brief Appends a record's file and console lines to the output buffers.
+         * @param record Record to format.
+         * @param text Free text the record carries, or nullptr.
+         * @param consoleText Console version of the text of a Text record, or nullptr.
+         */
+        void format(const LogRecord& record, const std::string* text, const std::string* consoleText);
+
+        /**
+         * @brief Writes and flushes the output buffers.
+         * @param endBlock If true, the binary block being built is written however small;
+         *        otherwise only once it reaches chunkBytes.
+         */
+        void writeBuffers(bool endBlock);
+
+        /** @brief Body of the writer thread: drains the ring until close(). */
+        void writerLoop();
 
     public:
         /**
          * @brief Opens the log file and initializes all counters.
          * @param filename Path to the log file to create/overwrite.
          * @param enableConsole If true, events are also echoed to stdout (default: true).
+         * @param binary If true, the file is a binary log (see BinaryLog) to be read back
+         *        with logdecode; the console output stays text (default: false).
+         */
+        LogFile(const std::string& filename, bool enableConsole = true, bool binary = false);
+
+        /**
+         * @brief Creates a stats-only log that writes nothing and only keeps the counters.
+         *
+         * Used by headless runs such as the parameter sweep.
          */
-        LogFile(const std::string& filename, bool enableConsole = true);
+        LogFile();
 
         /**
-         * @brief Destructor. Closes the log file if still open.
+         * @brief Destructor. Writes any queued entries and closes the log file.
          */
         ~LogFile();
 
+        /**
+         * @brief Appends the text-log line of a record, without the trailing newline.
+         *
+         * Shared with logdecode so a decoded binary log reads exactly like a text one.
+         *
+         * @param line Receives the line.
+         * @param record Record of any type but Text.
+         * @param text Free text the record carries (event message, shed reason or top-talker list), or nullptr.
+         */
+        static void formatLine(std::string& line, const LogRecord& record, const std::string* text);
+
+        /**
+         * @brief Hands formatting and writing to a background writer thread.
+         *
+         * Does nothing if the log is already asynchronous or writes nowhere.
+         *
+         * @param bufferSize Records the ring holds, rounded up to a power of two.
+         * @param dropWhenFull If true, a record that finds the ring full is dropped and
+         *        counted; otherwise the caller waits for the writer. Entries carrying
+         *        free text always wait.
+         */
+        void startAsync(int bufferSize, bool dropWhenFull);
+
+        /**
+         * @brief Replaces the per-event console lines with a live Dashboard.
+         *
+         * The file still gets every entry; the console shows the dashboard
+         * and, once the run ends, the header and summary.
+         *
+         * @param refreshRate Most redraws per second.
+         * @param totalRunTime Cycles the run will take.
+         */
+        void startDashboard(int refreshRate, int totalRunTime);
+
+        /**
+         * @brief Parses a category list such as "scaling,status".
+         * @param list Comma-separated names: requests, rejections, scaling, status, events, or all.
+         * @param mask Receives the LogCategory bitmask.
+         * @return false if a name is unknown.
+         */
+        static bool parseCategories(const std::string& list, unsigned& mask);
+
+        /**
+         * @brief Chooses which categories of entries are written; the counters are unaffected.
+         * @param mask Bitmask of LogCategory values (see parseCategories()).
+         */
+        void setCategories(unsigned mask);
+
+        /**
+         * @brief Keeps only 1 in rate of the per-request entries (requests and rejections).
+         * @param rate Sampling rate; 1 (or less) keeps every entry.
+         */
+        void setSampleRate(int rate);
+
         /**
          * @brief Enables or disables mirroring log entries to the console.
          * @param enable true to enable console output, false to suppress it.
@@ -77,8 +283,9 @@ class LogFile {
          * @brief Logs a generic simulation event message.
          * @param cycle Current clock cycle number.
          * @param message Descriptive event message to record.
+         * @param category Category the message belongs to (default: Events).
          */
-        void logEvent(int cycle, const std::string& message);
+        void logEvent(int cycle, const std::string& message, LogCategory category = LogCategory::Events);
 
         /**
          * @brief Logs the creation of a new web server.
@@ -98,28 +305,59 @@ class LogFile {
          * @brief Logs the start of request processing by a server.
          * @param cycle Current clock cycle number.
          * @param serverId Unique ID of the server that accepted the request.
-         * @param ipIn Source IP address of the request.
-         * @param ipOut Destination IP address of the request.
+         * @param ipIn Source IPv4 address of the request (formatted only if a line is written).
+         * @param ipOut Destination IPv4 address of the request.
          * @param processTime Number of clock cycles required to process the request.
          */
-        void logRequestStarted(int cycle, int serverId, const std::string& ipIn, const std::string& ipOut, int processTime);
+        void logRequestStarted(int cycle, int serverId, uint32_t ipIn, uint32_t ipOut, int processTime);
 
         /**
          * @brief Logs the successful completion of a request.
          * @param cycle Current clock cycle number.
          * @param serverId Unique ID of the server that finished the request.
-         * @param ipIn Source IP address of the completed request.
-         * @param ipOut Destination IP address of the completed request.
+         * @param ipIn Source IPv4 address of the completed request.
+         * @param ipOut Destination IPv4 address of the completed request.
          * @param processTime Number of clock cycles the request took to process.
          */
-        void logRequestProcessed(int cycle, int serverId, const std::string& ipIn, const std::string& ipOut, int processTime);
+        void logRequestProcessed(int cycle, int serverId, uint32_t ipIn, uint32_t ipOut, int processTime);
 
         /**
          * @brief Logs a request that was rejected due to a blocked IP range.
          * @param cycle Current clock cycle number.
-         * @param ip Source IP address of the blocked request.
+         * @param ip Source IPv4 address of the blocked request.
          */
-        void logRequestBlocked(int cycle, const std::string& ip);
+        void logRequestBlocked(int cycle, uint32_t ip);
+
+        /**
+         * @brief Logs a request shed by admission control.
+         * @param cycle Current clock cycle number.
+         * @param ip Source IPv4 address of the shed request.
+         * @param reason Why it was shed, e.g. "queue full".
+         */
+        void logRequestShed(int cycle, uint32_t ip, const std::string& reason);
+
+        /**
+         * @brief Logs a request rejected because its source exceeded its rate limit.
+         * @param cycle Current clock cycle number.
+         * @param ip Source IPv4 address of the rejected request.
+         */
+        void logRequestRateLimited(int cycle, uint32_t ip);
+
+        /**
+         * @brief Logs a source added to the blocklist for sending too many requests; its request is rejected.
+         * @param cycle Current clock cycle number.
+         * @param ip Source IPv4 address now blocked.
+         * @param count Requests counted from the source in the window when it was blocked.
+         * @param window Cycles within which they were sent.
+         */
+        void logSourceAutoBlocked(int cycle, uint32_t ip, int count, int window);
+
+        /**
+         * @brief Logs the heaviest sources seen so far.
+         * @param cycle Current clock cycle number.
+         * @param talkers Heaviest sources, heaviest first.
+         */
+        void logTopTalkers(int cycle, const std::vector<Talker>& talkers);
 
         /**
          * @brief Logs a periodic status snapshot of the simulation state.
@@ -129,16 +367,42 @@ class LogFile {
          */
         void logStatus(int cycle, int queueSize, int serverCount);
 
+        /**
+         * @brief Logs the wait and end-to-end percentiles of the requests completed since the last status, if any.
+         * @param cycle Current clock cycle number.
+         * @param waits Queue waits over the interval.
+         * @param latencies End-to-end times over the interval.
+         */
+        void logLatency(int cycle, const WaitStats& waits, const WaitStats& latencies);
+
+        /**
+         * @brief Tracks the peak queue depth and how long the queue took to drain after it.
+         *
+         * Writes nothing to the log; the results appear in the summary. Also
+         * feeds the dashboard, if any.
+         *
+         * @param cycle Current clock cycle number.
+         * @param queueSize Number of requests currently waiting to start.
+         */
+        void recordQueueDepth(int cycle, int queueSize);
+
         /**
          * @brief Writes a formatted summary of the entire simulation run.
          * @param totalTime Total number of clock cycles the simulation ran.
          * @param finalServerCount Number of servers active at simulation end.
          * @param finalQueueSize Number of requests remaining in the queue at simulation end.
+         * @param autoscaler Name of the autoscaler used.
+         * @param dispatchPolicy Name of the dispatch policy used.
+         * @param shedPolicy Name of the shed policy used.
+         * @param timings Queue waits of started requests and end-to-end times of completed ones.
+         * @param topTalkers Heaviest sources over the run, heaviest first; the section is omitted if empty.
          */
-        void writeSummary(int totalTime, int finalServerCount, int finalQueueSize);
+        void writeSummary(int totalTime, int finalServerCount, int finalQueueSize, const std::string& autoscaler,
+                          const std::string& dispatchPolicy, const std::string& shedPolicy, const RequestTimings& timings,
+                          const std::vector<Talker>& topTalkers);
 
         /**
-         * @brief Explicitly closes the log file output stream.
+         * @brief Writes every queued entry, stops the writer thread and closes the log file.
          */
         void close();
 
@@ -153,6 +417,40 @@ class LogFile {
 
         /** @brief Returns the total number of requests blocked due to IP filtering. */
         int getRequestsBlocked() const;
+
+        /** @brief Returns the total number of requests shed by admission control. */
+        int getRequestsShed() const;
+
+        /** @brief Returns the total number of requests rejected by rate limiting. */
+        int getRequestsRateLimited() const;
+
+        /** @brief Returns the number of sources blocked automatically. */
+        int getSourcesAutoBlocked() const;
+
+        /** @brief Returns the number of entries dropped because the async buffer was full. */
+        long long getRecordsDropped() const;
 };
 
+inline bool LogFile::wants(LogCategory category) const {
+    return (LOG_COMPILED_CATEGORIES & static_cast<unsigned>(category)) && (enabledCategories & static_cast<unsigned>(category));
+}
+
+inline bool LogFile::sampled(uint32_t ipIn, uint32_t ipOut) const {
+    return sampleRate <= 1 ||
+           static_cast<uint32_t>(((ipIn * 0x9E3779B97F4A7C15ULL) ^ ipOut) * 0xC2B2AE3D27D4EB4FULL >> 32) < sampleThreshold;
+}
+
+inline void LogFile::logRequestStarted(int cycle, int serverId, uint32_t ipIn, uint32_t ipOut, int processTime) {
+    if (wants(LogCategory::Requests) && sampled(ipIn, ipOut)) {
+        emit(LogRecord{cycle, LogEventType::RequestStarted, serverId, ipIn, ipOut, processTime});
+    }
+}
+
+inline void LogFile::logRequestProcessed(int cycle, int serverId, uint32_t ipIn, uint32_t ipOut, int processTime) {
+    requestsProcessed++;
+    if (wants(LogCategory::Requests) && sampled(ipIn, ipOut)) {
+        emit(LogRecord{cycle, LogEventType::RequestProcessed, serverId, ipIn, ipOut, processTime});
+    }
+}
+
 #endif
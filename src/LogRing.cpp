@@ -0,0 +1,52 @@
+/**
+ * @file LogRing.cpp
+ * @brief Implementation of the LogRing class.
+ */
+
+#include "LogRing.h"
+#include <algorithm>
+
+LogRing::LogRing(int capacity) : head(0), cachedTail(0), tail(0), cachedHead(0) {
+    size_t size = 2;
+    while (size < static_cast<size_t>(std::max(capacity, 2))) {
+        size *= 2;
+    }
+    records.reset(new LogRecord[size]);
+    mask = size - 1;
+}
+
+bool LogRing::tryPush(const LogRecord& record) {
+    size_t position = tail.load(std::memory_order_relaxed);
+    if (position - cachedHead > mask) {
+        cachedHead = head.load(std::memory_order_acquire);
+        if (position - cachedHead > mask) {
+            return false;
+        }
+    }
+    records[position & mask] = record;
+    tail.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+size_t LogRing::popBatch(LogRecord* out, size_t maxCount) {
+    size_t position = head.load(std::memory_order_relaxed);
+    if (cachedTail == position) {
+        cachedTail = tail.load(std::memory_order_acquire);
+    }
+    size_t count = std::min(cachedTail - position, maxCount);
+    for (size_t i = 0; i < count; i++) {
+        out[i] = records[(position + i) & mask];
+    }
+    head.store(position + count, std::memory_order_release);
+    return count;
+}
+
+size_t LogRing::sizeApprox() const {
+    size_t first = head.load(std::memory_order_relaxed);
+    size_t last = tail.load(std::memory_order_relaxed);
+    return last >= first ? last - first : 0;
+}
+
+size_t LogRing::capacity() const {
+    return mask + 1;
+}
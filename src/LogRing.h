@@ -0,0 +1,105 @@
+/**
+ * @file LogRing.h
+ * @brief Declaration of the LogRecord event record and the LogRing single-producer queue that carries it.
+ */
+
+#ifndef LOGRING_H
+#define LOGRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @enum LogEventType
+ * @brief Kind of a logged event, which also says how a LogRecord's fields are used.
+ */
+enum class LogEventType : uint8_t {
+    Event,                ///< Free-form message; the text travels separately
+    ServerAdded,          ///< number is the server id
+    ServerRemoved,        ///< number is the server id
+    RequestStarted,       ///< number is the server id, value the process time
+    RequestProcessed,     ///< number is the server id, value the process time
+    RequestBlocked,       ///< ipIn is the source
+    RequestShed,          ///< ipIn is the source, value the interned reason (-1: the text travels separately)
+    RequestRateLimited,   ///< ipIn is the source
+    SourceAutoBlocked,    ///< ipIn is the source, value the requests counted, number the window
+    TopTalkers,           ///< The formatted list travels separately
+    Status,               ///< value is the queue size, number the server count
+    Text,                 ///< Preformatted file and console text travel separately
+    Latency               ///< The formatted interval percentiles travel separately
+};
+
+/**
+ * @struct LogRecord
+ * @brief One log event in fixed-size numeric form, formatted only when written.
+ */
+struct LogRecord {
+    int cycle;            ///< Clock cycle of the event
+    LogEventType type;    ///< Kind of event
+    int number;           ///< Server id, server count or window, by type
+    uint32_t ipIn;        ///< Source IPv4 address, if any
+    uint32_t ipOut;       ///< Destination IPv4 address, if any
+    int value;            ///< Process time, queue size, request count or reason, by type
+};
+
+/**
+ * @class LogRing
+ * @brief Bounded single-producer, single-consumer queue of log records.
+ *
+ * A power-of-two array with a head index owned by the consumer and a tail
+ * index owned by the producer, each on its own cache line. Each side keeps
+ * a private copy of the other's index and rereads the shared one only when
+ * the copy says the ring is full (producer) or empty (consumer), so in the
+ * steady state a push or a batch pop touches no cache line the other side
+ * is writing.
+ */
+class LogRing {
+    private:
+        std::unique_ptr<LogRecord[]> records;      ///< Ring storage; the size is a power of two
+        size_t mask;                               ///< Ring size - 1
+        alignas(64) std::atomic<size_t> head;      ///< Next position to read; written by the consumer
+        size_t cachedTail;                         ///< Consumer's last view of tail
+        alignas(64) std::atomic<size_t> tail;      ///< Next position to write; written by the producer
+        size_t cachedHead;                         ///< Producer's last view of head
+
+    public:
+        /**
+         * @brief Creates an empty ring.
+         * @param capacity Requested capacity, rounded up to a power of two (at least 2).
+         */
+        explicit LogRing(int capacity);
+
+        LogRing(const LogRing&) = delete;
+        LogRing& operator=(const LogRing&) = delete;
+
+        /**
+         * @brief Appends a record. Producer thread only.
+         * @param record Record to append.
+         * @return true if the record was queued, false if the ring was full.
+         */
+        bool tryPush(const LogRecord& record);
+
+        /**
+         * @brief Removes up to maxCount of the oldest records. Consumer thread only.
+         * @param out Receives the records, oldest first.
+         * @param maxCount Most records to remove.
+         * @return Number of records removed.
+         */
+        size_t popBatch(LogRecord* out, size_t maxCount);
+
+        /**
+         * @brief Returns the number of queued records; exact on either thread only for its own side's changes.
+         * @return Approximate size.
+         */
+        size_t sizeApprox() const;
+
+        /**
+         * @brief Returns the number of records the ring can hold.
+         * @return Capacity.
+         */
+        size_t capacity() const;
+};
+
+#endif
@@ -0,0 +1,166 @@
+/**
+ * @file MetricsRecorder.cpp
+ * @brief Implementation of the MetricsRecorder class.
+ */
+
+#include "MetricsRecorder.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+const char* const MetricsRecorder::columnNames[MetricsRecorder::columnCount] = {
+    "queue_depth", "servers", "busy_servers", "arrivals", "completions",
+    "blocked", "rejected", "servers_added", "servers_removed"
+};
+
+MetricsRecorder::MetricsRecorder(const std::string& filename, int interval, int totalRunTime, bool csv)
+    : filename(filename), csv(csv), interval(std::max(interval, 1)), rowCapacity(0), fd(-1), failed(false),
+      buffer(columnCount * chunkRows, 0), chunkStart(0), chunkFill(0), currentRow(-1), latest(), previous() {
+    // a multiple of 1024 rows keeps every column page-aligned
+    long long rows = (std::max(totalRunTime, 1) + this->interval - 1) / this->interval;
+    rowCapacity = (rows + 1023) / 1024 * 1024;
+
+    if (csv) {
+        csvFile.open(filename);
+        if (csvFile.is_open()) {
+            csvFile << "cycle";
+            for (const char* name : columnNames) {
+                csvFile << ',' << name;
+            }
+            csvFile << '\n';
+        }
+        return;
+    }
+    fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return;
+    }
+    if (ftruncate(fd, headerBytes + columnCount * rowCapacity * sizeof(int32_t)) != 0) {
+        failed = true;
+    }
+    writeHeader();
+}
+
+MetricsRecorder::~MetricsRecorder() {
+    if (isOpen()) {
+        finish(0);
+    }
+}
+
+bool MetricsRecorder::isOpen() const {
+    return csv ? csvFile.is_open() : fd >= 0;
+}
+
+void MetricsRecorder::record(int cycle, const MetricsSample& sample) {
+    long long row = cycle / interval;
+    if (row != currentRow) {
+        if (currentRow >= 0) {
+            commitRow(latest);
+        }
+        // rows with no sample held the state the previous row ended with
+        long long end = csv ? row : std::min(row, rowCapacity);
+        while (getRows() < end) {
+            commitRow(previous);
+        }
+        currentRow = row;
+    }
+    latest = sample;
+}
+
+void MetricsRecorder::commitRow(const MetricsSample& sample) {
+    if (!csv && getRows() >= rowCapacity) {
+        return;
+    }
+    int32_t* row = buffer.data() + chunkFill;
+    row[0] = sample.queueDepth;
+    row[chunkRows] = sample.servers;
+    row[2 * chunkRows] = sample.busyServers;
+    row[3 * chunkRows] = static_cast<int32_t>(sample.arrivals - previous.arrivals);
+    row[4 * chunkRows] = static_cast<int32_t>(sample.completions - previous.completions);
+    row[5 * chunkRows] = static_cast<int32_t>(sample.blocked - previous.blocked);
+    row[6 * chunkRows] = static_cast<int32_t>(sample.rejected - previous.rejected);
+    row[7 * chunkRows] = static_cast<int32_t>(sample.serversAdded - previous.serversAdded);
+    row[8 * chunkRows] = static_cast<int32_t>(sample.serversRemoved - previous.serversRemoved);
+    previous = sample;
+    if (++chunkFill == chunkRows) {
+        flushChunk();
+    }
+}
+
+void MetricsRecorder::flushChunk() {
+    if (chunkFill == 0) {
+        return;
+    }
+    if (csv) {
+        std::string text;
+        for (int i = 0; i < chunkFill; i++) {
+            text += std::to_string((chunkStart + i) * interval);
+            for (int c = 0; c < columnCount; c++) {
+                text += ',';
+                text += std::to_string(buffer[c * chunkRows + i]);
+            }
+            text += '\n';
+        }
+        csvFile.write(text.data(), text.size());
+    } else {
+        size_t bytes = chunkFill * sizeof(int32_t);
+        for (int c = 0; c < columnCount; c++) {
+            off_t offset = headerBytes + (c * rowCapacity + chunkStart) * sizeof(int32_t);
+            if (pwrite(fd, buffer.data() + c * chunkRows, bytes, offset) != static_cast<ssize_t>(bytes)) {
+                failed = true;
+            }
+        }
+    }
+    chunkStart += chunkFill;
+    chunkFill = 0;
+}
+
+void MetricsRecorder::writeHeader() {
+    char header[headerBytes] = {};
+    std::memcpy(header, "LBMETRIC", 8);
+    uint32_t fields[6] = {1, columnCount, static_cast<uint32_t>(interval), static_cast<uint32_t>(getRows()),
+                          static_cast<uint32_t>(rowCapacity), headerBytes};
+    std::memcpy(header + 8, fields, sizeof(fields));
+    for (int c = 0; c < columnCount; c++) {
+        std::memcpy(header + 32 + c * nameBytes, columnNames[c], std::strlen(columnNames[c]));
+    }
+    if (pwrite(fd, header, headerBytes, 0) != headerBytes) {
+        failed = true;
+    }
+}
+
+bool MetricsRecorder::finish(int totalTime) {
+    if (!isOpen()) {
+        return !failed;
+    }
+    if (currentRow >= 0) {
+        commitRow(latest);
+        currentRow = -1;
+    }
+    long long endRow = (static_cast<long long>(totalTime) + interval - 1) / interval;
+    long long end = csv ? endRow : std::min(endRow, rowCapacity);
+    while (getRows() < end) {
+        commitRow(previous);
+    }
+    flushChunk();
+
+    if (csv) {
+        csvFile.flush();
+        if (!csvFile) {
+            failed = true;
+        }
+        csvFile.close();
+    } else {
+        writeHeader();
+        if (::close(fd) != 0) {
+            failed = true;
+        }
+        fd = -1;
+    }
+    return !failed;
+}
+
+long long MetricsRecorder::getRows() const {
+    return chunkStart + chunkFill;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file MetricsRecorder.h
+ * @brief Declaration of the MetricsRecorder class, the per-cycle time series written to metricsFile.
+ */
+
+#ifndef METRICSRECORDER_H
+#define METRICSRECORDER_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @struct MetricsSample
+ * @brief Simulation state at the end of a cycle; counts are running totals since the start of the run.
+ */
+struct MetricsSample {
+    int queueDepth;           ///< Requests waiting to start
+    int servers;              ///< Active servers
+    int busyServers;          ///< Servers processing a request
+    long long arrivals;       ///< Requests offered, the initial queue and blocked ones included
+    long long completions;    ///< Requests completed
+    long long blocked;        ///< Requests blocked by range or auto-block
+    long long rejected;       ///< Requests shed or rate limited
+    long long serversAdded;   ///< Servers created, initial ones included
+    long long serversRemoved; ///< Servers deallocated
+};
+
+/**
+ * @class MetricsRecorder
+ * @brief Records one row of columns every interval cycles into preallocated buffers flushed in chunks.
+ *
+ * Row r covers cycles [r * interval, (r + 1) * interval): queue depth and
+ * the server counts are as of the last sample in the row, and the other
+ * columns count what happened within it. Cycles that are never sampled
+ * (between events in event mode) repeat the last state with zero counts.
+ * Recording a sample is a division and a copy; a row is nine stores, and
+ * every chunkRows rows the buffers are written out with one pwrite per
+ * column, so memory stays fixed however long the run.
+ *
+ * In binary format the file is a 4096-byte header followed by one
+ * contiguous column per metric, each rowCapacity int32 values in host byte
+ * order (little-endian on x86 and ARM). rowCapacity is a multiple of 1024,
+ * so every column starts on a page boundary and the file can be mapped
+ * and read in place. Header, all fields uint32 after the magic:
+ *
+ * | Offset | Field |
+ * |--------|-------|
+ * | 0 | magic "LBMETRIC" |
+ * | 8 | version (1) |
+ * | 12 | column count |
+ * | 16 | interval, cycles per row |
+ * | 20 | rows written |
+ * | 24 | rowCapacity |
+ * | 28 | data offset (4096) |
+ * | 32 | column names, 16 NUL-padded bytes each |
+ *
+ * Column c starts at data offset + c * rowCapacity * 4, e.g. in Python:
+ * @code{.py}
+ * cols = numpy.memmap("metrics.bin", dtype="<i4", mode="r", offset=4096,
+ *                     shape=(column_count, row_capacity))[:, :rows]
+ * @endcode
+ *
+ * In CSV format each row is a line starting with the row's first cycle.
+ */
+class MetricsRecorder {
+    private:
+        static const int columnCount = 9;           ///< Metrics per row
+        static const int chunkRows = 16384;         ///< Rows buffered between writes
+        static const int headerBytes = 4096;        ///< Bytes before the first column
+        static const int nameBytes = 16;            ///< Header bytes per column name
+        static const char* const columnNames[columnCount]; ///< Column names, in file order
+
+        std::string filename;            ///< Output path
+        bool csv;                        ///< Whether rows are written as CSV text
+        int interval;                    ///< Cycles per row
+        long long rowCapacity;           ///< Rows the binary columns have room for
+        int fd;                          ///< Binary output, or -1
+        std::ofstream csvFile;           ///< CSV output
+        bool failed;                     ///< Whether a write failed
+        std::vector<int32_t> buffer;     ///< Buffered rows, column-major: column c at c * chunkRows
+        long long chunkStart;            ///< Row number of the first buffered row
+        int chunkFill;                   ///< Rows buffered
+        long long currentRow;            ///< Row the latest sample belongs to, or -1 before the first
+        MetricsSample latest;            ///< Latest sample
+        MetricsSample previous;          ///< Sample the last written row ended with; counts are relative to it
+
+        /**
+         * @brief Appends a row ending with the given sample.
+         * @param sample State at the end of the row.
+         */
+        void commitRow(const MetricsSample& sample);
+
+        /** @brief Writes the buffered rows out and empties the buffers. */
+        void flushChunk();
+
+        /** @brief Writes the binary header with the current row count. */
+        void writeHeader();
+
+    public:
+        /**
+         * @brief Creates the output file; check isOpen() afterwards.
+         * @param filename Output path.
+         * @param interval Cycles per row (at least 1).
+         * @param totalRunTime Cycles the run will take, which sizes the binary columns.
+         * @param csv true for CSV text, false for the binary columnar format.
+         */
+        MetricsRecorder(const std::string& filename, int interval, int totalRunTime, bool csv);
+
+        /** @brief Finishes the file if finish() was not called. */
+        ~MetricsRecorder();
+
+        MetricsRecorder(const MetricsRecorder&) = delete;
+        MetricsRecorder& operator=(const MetricsRecorder&) = delete;
+
+        /** @brief Returns whether the output file was created. */
+        bool isOpen() const;
+
+        /**
+         * @brief Records the state at the end of a cycle; cycles must not decrease.
+         * @param cycle Clock cycle just simulated.
+         * @param sample State at the end of the cycle.
+         */
+        void record(int cycle, const MetricsSample& sample);
+
+        /**
+         * @brief Writes the remaining rows, carrying the last state up to the end of the run, and closes the file.
+         * @param totalTime Cycles the run took.
+         * @return true if every write succeeded.
+         */
+        bool finish(int totalTime);
+
+        /** @brief Returns the number of rows written so far. */
+        long long getRows() const;
+};
+
+#endif
@@ -0,0 +1,124 @@
+/**
+ * @file OpenAddressTable.h
+ * @brief Declaration of the OpenAddressTable class template, a linear-probing table keyed by IPv4 address.
+ */
+
+#ifndef OPENADDRESSTABLE_H
+#define OPENADDRESSTABLE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class OpenAddressTable
+ * @brief Power-of-two array of slots addressed by a multiply-shift hash of an IPv4 address.
+ *
+ * The table only knows where an address belongs; what a slot holds is up to
+ * the owner. Probing and removal take an accessor with two const members:
+ * occupied(slot), which tells a used slot from an empty one, and key(slot),
+ * which returns the address stored in a used slot. An owner whose slots
+ * refer to records elsewhere (an index into another array) can then look
+ * the address up there.
+ *
+ * Collisions are resolved by linear probing. Removal shifts later entries
+ * of the probe run back into the gap, so the table never holds tombstones
+ * and a probe ends at the first empty slot.
+ *
+ * @tparam Slot Slot type; copied when entries shift.
+ */
+template <typename Slot>
+class OpenAddressTable {
+    private:
+        std::vector<Slot> slots;   ///< The table; the size is a power of two
+        size_t mask;               ///< Number of slots - 1
+        Slot empty;                ///< Value of an empty slot
+
+    public:
+        /**
+         * @brief Creates a table of empty slots.
+         * @param minSlots Fewest slots the table needs; rounded up to a power of two, at least 2.
+         * @param empty Value of an empty slot.
+         */
+        OpenAddressTable(size_t minSlots, const Slot& empty) : empty(empty) {
+            size_t size = 2;
+            while (size < minSlots) {
+                size *= 2;
+            }
+            slots.assign(size, empty);
+            mask = size - 1;
+        }
+
+        /**
+         * @brief Returns the home slot of an address.
+         * @param ip Address.
+         * @return Slot index.
+         */
+        size_t home(uint32_t ip) const {
+            return (static_cast<uint64_t>(ip) * 0x9E3779B97F4A7C15ULL >> 32) & mask;
+        }
+
+        /**
+         * @brief Returns the slot holding an address, or the empty slot that ends its probe run.
+         * @param ip Address.
+         * @param access Accessor for the slots.
+         * @return Slot index; the slot is empty if the address is not in the table.
+         */
+        template <typename Access>
+        size_t probe(uint32_t ip, const Access& access) const {
+            size_t slot = home(ip);
+            while (access.occupied(slots[slot]) && access.key(slots[slot]) != ip) {
+                slot = (slot + 1) & mask;
+            }
+            return slot;
+        }
+
+        /**
+         * @brief Empties a slot and shifts the rest of its probe run back to close the gap.
+         * @param slot Occupied slot to empty.
+         * @param access Accessor for the slots.
+         */
+        template <typename Access>
+        void erase(size_t slot, const Access& access) {
+            size_t hole = slot;
+            size_t next = (hole + 1) & mask;
+            while (access.occupied(slots[next])) {
+                // an entry may fill the hole only if its home is not between the hole and itself
+                size_t distance = (next - home(access.key(slots[next]))) & mask;
+                if (distance >= ((next - hole) & mask)) {
+                    slots[hole] = slots[next];
+                    hole = next;
+                }
+                next = (next + 1) & mask;
+            }
+            slots[hole] = empty;
+        }
+
+        /** @brief Empties every slot, keeping the allocated memory. */
+        void clear() {
+            std::fill(slots.begin(), slots.end(), empty);
+        }
+
+        /** @brief Returns the slot at an index. */
+        Slot& operator[](size_t slot) {
+            return slots[slot];
+        }
+
+        /** @brief Returns the slot at an index. */
+        const Slot& operator[](size_t slot) const {
+            return slots[slot];
+        }
+
+        /** @brief Returns the index of the slot after another, wrapping at the end. */
+        size_t next(size_t slot) const {
+            return (slot + 1) & mask;
+        }
+
+        /** @brief Returns the number of slots. */
+        size_t capacity() const {
+            return slots.size();
+        }
+};
+
+#endif
@@ -0,0 +1,69 @@
+/**
+ * @file RateLimiter.cpp
+ * @brief Implementation of the RateLimiter class.
+ */
+
+#include "RateLimiter.h"
+#include <algorithm>
+
+RateLimiter::RateLimiter(double rate, double burst, int maxSources)
+    : slots((static_cast<size_t>(std::max(maxSources, 1)) * 4 + 2) / 3, Bucket{0, 0, 0.0f, 0, 0}),
+      count(0), maxSources(std::max(maxSources, 1)), hand(0), rate(rate), burst(std::max(burst, 1.0)), evictions(0) {
+}
+
+bool RateLimiter::allow(uint32_t ip, int cycle) {
+    size_t slot = slots.probe(ip, BucketAccess());
+    if (slots[slot].occupied) {
+        Bucket& bucket = slots[slot];
+        double tokens = std::min(burst, bucket.tokens + static_cast<double>(cycle - bucket.lastCycle) * rate);
+        bucket.lastCycle = cycle;
+        bucket.referenced = 1;
+        if (tokens < 1.0) {
+            bucket.tokens = tokens;
+            return false;
+        }
+        bucket.tokens = tokens - 1.0;
+        return true;
+    }
+
+    if (count == maxSources) {
+        // eviction may shift entries into this probe run, so search for the free slot again
+        evict();
+        slot = slots.probe(ip, BucketAccess());
+    }
+    // new sources start unreferenced, so a flood of one-off addresses evicts its own kind first
+    slots[slot] = Bucket{ip, cycle, static_cast<float>(burst - 1.0), 1, 0};
+    count++;
+    return true;
+}
+
+void RateLimiter::evict() {
+    // at most two sweeps: the first clears every referenced bit it passes
+    while (true) {
+        size_t slot = hand;
+        hand = slots.next(hand);
+        if (!slots[slot].occupied) {
+            continue;
+        }
+        if (slots[slot].referenced) {
+            slots[slot].referenced = 0;
+            continue;
+        }
+        slots.erase(slot, BucketAccess());
+        count--;
+        evictions++;
+        return;
+    }
+}
+
+size_t RateLimiter::getTrackedSources() const {
+    return count;
+}
+
+long long RateLimiter::getEvictions() const {
+    return evictions;
+}
+
+size_t RateLimiter::getMemoryBytes() const {
+    return slots.capacity() * sizeof(Bucket);
+}
@@ -0,0 +1,93 @@
+/**
+ * @file RateLimiter.h
+ * @brief Declaration of the RateLimiter class, a per-source-IP token bucket limiter.
+ */
+
+#ifndef RATELIMITER_H
+#define RATELIMITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include "OpenAddressTable.h"
+
+/**
+ * @class RateLimiter
+ * @brief Token bucket per source IPv4 address, in a fixed-size table.
+ *
+ * Each source earns rate tokens per clock cycle up to a burst capacity, and
+ * every admitted request spends one. Buckets are refilled lazily: an entry
+ * only records its token count and the cycle it was last touched, and the
+ * tokens earned since are added when the source is next seen. A source with
+ * no entry starts with a full bucket.
+ *
+ * Entries live in one OpenAddressTable, 16 bytes each, sized for
+ * maxSources at a load factor of at most 3/4, so memory is fixed however
+ * many distinct sources arrive. When the table holds maxSources entries a
+ * new source evicts one chosen by CLOCK: a hand sweeps the slots, clearing
+ * the referenced bit of entries used since its last pass and evicting the
+ * first entry whose bit is already clear.
+ */
+class RateLimiter {
+    private:
+        /**
+         * @struct Bucket
+         * @brief One source's token bucket.
+         */
+        struct Bucket {
+            uint32_t ip;           ///< Source address
+            int lastCycle;         ///< Cycle the tokens were last brought up to date
+            float tokens;          ///< Tokens available as of lastCycle
+            uint8_t occupied;      ///< 1 if the slot holds a bucket
+            uint8_t referenced;    ///< Set on use, cleared by the CLOCK hand
+        };
+
+        /**
+         * @struct BucketAccess
+         * @brief Tells OpenAddressTable which slots hold a bucket and for which address.
+         */
+        struct BucketAccess {
+            bool occupied(const Bucket& bucket) const { return bucket.occupied; }
+            uint32_t key(const Bucket& bucket) const { return bucket.ip; }
+        };
+
+        OpenAddressTable<Bucket> slots;   ///< Buckets by source address
+        size_t count;                     ///< Occupied slots
+        size_t maxSources;                ///< Most buckets kept at once
+        size_t hand;                      ///< Next slot the CLOCK hand examines
+        double rate;                      ///< Tokens earned per cycle
+        double burst;                     ///< Bucket capacity
+        long long evictions;              ///< Buckets evicted to make room
+
+        /**
+         * @brief Evicts one bucket chosen by the CLOCK hand.
+         */
+        void evict();
+
+    public:
+        /**
+         * @brief Creates a limiter with no buckets.
+         * @param rate Tokens each source earns per cycle.
+         * @param burst Bucket capacity: the most requests a source can send at once (at least 1).
+         * @param maxSources Most sources tracked at once (at least 1).
+         */
+        RateLimiter(double rate, double burst, int maxSources);
+
+        /**
+         * @brief Spends a token from a source's bucket if it has one.
+         * @param ip Source address.
+         * @param cycle Current clock cycle; never decreases between calls.
+         * @return true if the request is within the source's rate, false if it should be rejected.
+         */
+        bool allow(uint32_t ip, int cycle);
+
+        /** @brief Returns the number of sources currently tracked. */
+        size_t getTrackedSources() const;
+
+        /** @brief Returns the number of buckets evicted to make room for new sources. */
+        long long getEvictions() const;
+
+        /** @brief Returns the bytes used by the table. */
+        size_t getMemoryBytes() const;
+};
+
+#endif
@@ -4,23 +4,19 @@
  */
 
 #include "Request.h"
-#include <cstdlib>
-#include <iomanip>
-#include <sstream>
-#include <random>
 
-Request::Request() : ipIn("000.000.000.000"), ipOut("000.000.000.000"), processTime(0), jobType('P') {
+Request::Request() : ipIn(0), ipOut(0), processTime(0), jobType('P'), arrivalTime(0), dispatchTime(0) {
 }
 
-Request::Request(std::string ipIn, std::string ipOut, int processTime, char jobType)
-    : ipIn(ipIn), ipOut(ipOut), processTime(processTime), jobType(jobType){
+Request::Request(uint32_t ipIn, uint32_t ipOut, int processTime, char jobType)
+    : ipIn(ipIn), ipOut(ipOut), processTime(processTime), jobType(jobType), arrivalTime(0), dispatchTime(0){
 }
 
-std::string Request::getIpIn() const {
+uint32_t Request::getIpIn() const {
     return ipIn;
 }
 
-std::string Request::getIpOut() const {
+uint32_t Request::getIpOut() const {
     return ipOut;
 }
 
@@ -32,26 +28,40 @@ char Request::getJobType() const {
     return jobType;
 }
 
-std::string Request::generateRandomIp() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, 255);
+int Request::getArrivalTime() const {
+    return arrivalTime;
+}
 
-    std::ostringstream oss;
-    oss << dis(gen) << "."
-        << dis(gen) << "."
-        << dis(gen) << "."
-        << dis(gen);
+void Request::setArrivalTime(int cycle) {
+    arrivalTime = cycle;
+}
+
+int Request::getDispatchTime() const {
+    return dispatchTime;
+}
+
+void Request::setDispatchTime(int cycle) {
+    dispatchTime = cycle;
+}
+
+uint32_t Request::generateRandomIp(std::mt19937& gen) {
+    std::uniform_int_distribution<> dis(0, 255);
 
-    return oss.str();
+    uint32_t ip = 0;
+    for (int octet = 0; octet < 4; octet++) {
+        ip = (ip << 8) | dis(gen);
+    }
+    return ip;
 }
 
-Request Request::generateRandomRequest(int minTime, int maxTime){
-    std::string ipIn = generateRandomIp();
-    std::string ipOut = generateRandomIp();
+Request Request::generateRandomRequest(std::mt19937& gen, int minTime, int maxTime){
+    uint32_t ipIn = generateRandomIp(gen);
+    uint32_t ipOut = generateRandomIp(gen);
 
-    int processTime = minTime + (rand() % (maxTime - minTime + 1));
-    char jobType = (rand() % 2 == 0) ? 'P' : 'S';
+    std::uniform_int_distribution<> timeDis(minTime, maxTime);
+    std::uniform_int_distribution<> typeDis(0, 1);
+    int processTime = timeDis(gen);
+    char jobType = (typeDis(gen) == 0) ? 'P' : 'S';
 
     return Request(ipIn, ipOut, processTime, jobType);
 }
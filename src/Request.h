@@ -6,7 +6,8 @@
 #ifndef REQUEST_H
 #define REQUEST_H
 
-#include <string>
+#include <cstdint>
+#include <random>
 
 /**
  * @class Request
@@ -15,13 +16,19 @@
  * Stores the source IP, destination IP, estimated processing time, and job type
  * ('P' for processing, 'S' for streaming). Also provides static factory methods
  * for generating random requests and IPs.
+ *
+ * Request is a small fixed-size value: IPv4 addresses are kept as host-order
+ * 32-bit integers and only formatted as text when a log line is written (see
+ * IpRange::toString()), so copying or filtering a request never allocates.
  */
 class Request{
     private:
-        std::string ipIn;      ///< Source IP address of the request
-        std::string ipOut;     ///< Destination IP address of the request
+        uint32_t ipIn;         ///< Source IPv4 address of the request
+        uint32_t ipOut;        ///< Destination IPv4 address of the request
         int processTime;       ///< Number of clock cycles required to process this request
         char jobType;          ///< Job type: 'P' (processing) or 'S' (streaming)
+        int arrivalTime;       ///< Clock cycle at which the request entered the load balancer
+        int dispatchTime;      ///< Clock cycle at which a server started processing the request
     public:
         /**
          * @brief Default constructor. Initializes all fields to zero/default values.
@@ -30,24 +37,24 @@ class Request{
 
         /**
          * @brief Constructs a Request with explicit field values.
-         * @param ipIn Source IP address.
-         * @param ipOut Destination IP address.
+         * @param ipIn Source IPv4 address.
+         * @param ipOut Destination IPv4 address.
          * @param processTime Number of clock cycles to process this request.
          * @param jobType Job type character ('P' or 'S').
          */
-        Request(std::string ipIn, std::string ipOut, int processTime, char jobType);
+        Request(uint32_t ipIn, uint32_t ipOut, int processTime, char jobType);
 
         /**
          * @brief Returns the source IP address.
-         * @return Source IP as a string.
+         * @return Source IPv4 address in host byte order.
          */
-        std::string getIpIn() const;
+        uint32_t getIpIn() const;
 
         /**
          * @brief Returns the destination IP address.
-         * @return Destination IP as a string.
+         * @return Destination IPv4 address in host byte order.
          */
-        std::string getIpOut() const;
+        uint32_t getIpOut() const;
 
         /**
          * @brief Returns the processing time in clock cycles.
@@ -62,18 +69,44 @@ class Request{
         char getJobType() const;
 
         /**
-         * @brief Generates a random IPv4 address string.
-         * @return A randomly generated IP address in "a.b.c.d" format.
+         * @brief Returns the clock cycle at which the request was accepted.
+         * @return Arrival cycle.
+         */
+        int getArrivalTime() const;
+
+        /**
+         * @brief Stamps the clock cycle at which the request was accepted.
+         * @param cycle Arrival cycle.
+         */
+        void setArrivalTime(int cycle);
+
+        /**
+         * @brief Returns the clock cycle at which a server started processing the request.
+         * @return Dispatch cycle (0 until the request starts).
+         */
+        int getDispatchTime() const;
+
+        /**
+         * @brief Stamps the clock cycle at which a server started processing the request.
+         * @param cycle Dispatch cycle.
+         */
+        void setDispatchTime(int cycle);
+
+        /**
+         * @brief Generates a random IPv4 address.
+         * @param gen Random engine to draw from; the octets are drawn in order a, b, c, d.
+         * @return A randomly generated IPv4 address in host byte order.
          */
-        static std::string generateRandomIp();
+        static uint32_t generateRandomIp(std::mt19937& gen);
 
         /**
          * @brief Generates a Request with random source/destination IPs and a random process time.
+         * @param gen Random engine to draw from; the same engine state always yields the same request.
          * @param minTime Minimum processing time (inclusive).
          * @param maxTime Maximum processing time (inclusive).
          * @return A randomly generated Request object.
          */
-        static Request generateRandomRequest(int minTime, int maxTime);
+        static Request generateRandomRequest(std::mt19937& gen, int minTime, int maxTime);
 };
 
 #endif
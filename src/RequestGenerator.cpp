@@ -0,0 +1,172 @@
+/**
+ * @file RequestGenerator.cpp
+ * @brief Implementation of the RequestGenerator interface and the built-in engines.
+ */
+
+#include "RequestGenerator.h"
+#include <algorithm>
+#include <random>
+
+namespace {
+
+/**
+ * @brief SplitMix64 step, used to expand one seed into engine state.
+ */
+uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * @class XoshiroRequestGenerator
+ * @brief xoshiro256** over four interleaved lanes.
+ *
+ * Each state word is stored lane-major, so one step is the same scalar update
+ * applied to four independent streams with a fixed trip count, which the
+ * compiler turns into SIMD. One step yields four 64-bit words: two requests.
+ */
+class XoshiroRequestGenerator : public RequestGenerator {
+    private:
+        static const int lanes = 4;
+        uint64_t s0[lanes];
+        uint64_t s1[lanes];
+        uint64_t s2[lanes];
+        uint64_t s3[lanes];
+
+        void step(uint64_t* __restrict out) {
+            for (int j = 0; j < lanes; j++) {
+                uint64_t result = rotl(s1[j] * 5, 7) * 9;
+                uint64_t t = s1[j] << 17;
+                s2[j] ^= s0[j];
+                s3[j] ^= s1[j];
+                s1[j] ^= s2[j];
+                s0[j] ^= s3[j];
+                s2[j] ^= t;
+                s3[j] = rotl(s3[j], 45);
+                out[j] = result;
+            }
+        }
+
+    public:
+        XoshiroRequestGenerator(uint64_t seed, int minTime, int maxTime) : RequestGenerator(minTime, maxTime) {
+            for (int j = 0; j < lanes; j++) {
+                s0[j] = splitMix64(seed);
+                s1[j] = splitMix64(seed);
+                s2[j] = splitMix64(seed);
+                s3[j] = splitMix64(seed);
+            }
+        }
+
+        void fill(Request* out, int count) override {
+            uint64_t words[lanes];
+            int i = 0;
+            for (; i + 1 < count; i += 2) {
+                step(words);
+                out[i] = makeRequest(words[0], words[1] >> 32);
+                out[i + 1] = makeRequest(words[2], words[3] >> 32);
+            }
+            if (i < count) {
+                step(words);
+                out[i] = makeRequest(words[0], words[1] >> 32);
+            }
+        }
+
+        std::string getName() const override {
+            return "xoshiro256";
+        }
+};
+
+/**
+ * @class PcgRequestGenerator
+ * @brief PCG-XSH-RR 64/32; three 32-bit outputs per request.
+ */
+class PcgRequestGenerator : public RequestGenerator {
+    private:
+        uint64_t state;
+        uint64_t increment;
+
+        uint32_t nextWord() {
+            uint64_t old = state;
+            state = old * 6364136223846793005ULL + increment;
+            uint32_t xorShifted = ((old >> 18) ^ old) >> 27;
+            uint32_t rot = old >> 59;
+            return (xorShifted >> rot) | (xorShifted << ((-rot) & 31));
+        }
+
+    public:
+        PcgRequestGenerator(uint64_t seed, int minTime, int maxTime)
+            : RequestGenerator(minTime, maxTime), state(0), increment((seed << 1) | 1) {
+            nextWord();
+            state += seed;
+            nextWord();
+        }
+
+        void fill(Request* out, int count) override {
+            for (int i = 0; i < count; i++) {
+                uint64_t ipBits = static_cast<uint64_t>(nextWord()) << 32;
+                ipBits |= nextWord();
+                out[i] = makeRequest(ipBits, nextWord());
+            }
+        }
+
+        std::string getName() const override {
+            return "pcg32";
+        }
+};
+
+/**
+ * @class MersenneRequestGenerator
+ * @brief std::mt19937 with the per-octet draws of Request::generateRandomRequest().
+ */
+class MersenneRequestGenerator : public RequestGenerator {
+    private:
+        std::mt19937 engine;
+        int maxTime;
+
+    public:
+        MersenneRequestGenerator(uint64_t seed, int minTime, int maxTime)
+            : RequestGenerator(minTime, maxTime), engine(static_cast<std::mt19937::result_type>(seed)), maxTime(maxTime) {
+        }
+
+        void fill(Request* out, int count) override {
+            for (int i = 0; i < count; i++) {
+                out[i] = Request::generateRandomRequest(engine, minTime, maxTime);
+            }
+        }
+
+        std::string getName() const override {
+            return "mt19937";
+        }
+};
+
+}
+
+RequestGenerator::RequestGenerator(int minTime, int maxTime)
+    : minTime(minTime), timeRange(std::max(maxTime - minTime + 1, 1)) {
+}
+
+RequestGenerator::~RequestGenerator() {
+}
+
+Request RequestGenerator::makeRequest(uint64_t ipBits, uint32_t timeBits) const {
+    int processTime = minTime + static_cast<int>((static_cast<uint64_t>(timeBits) * timeRange) >> 32);
+    char jobType = (timeBits & 1) ? 'S' : 'P';
+    return Request(static_cast<uint32_t>(ipBits >> 32), static_cast<uint32_t>(ipBits), processTime, jobType);
+}
+
+std::unique_ptr<RequestGenerator> RequestGenerator::create(const std::string& name, uint64_t seed, int minTime, int maxTime) {
+    if (name == "xoshiro256") {
+        return std::unique_ptr<RequestGenerator>(new XoshiroRequestGenerator(seed, minTime, maxTime));
+    } else if (name == "pcg32") {
+        return std::unique_ptr<RequestGenerator>(new PcgRequestGenerator(seed, minTime, maxTime));
+    } else if (name == "mt19937") {
+        return std::unique_ptr<RequestGenerator>(new MersenneRequestGenerator(seed, minTime, maxTime));
+    }
+    return nullptr;
+}
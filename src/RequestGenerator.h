@@ -0,0 +1,73 @@
+/**
+ * @file RequestGenerator.h
+ * @brief Declaration of the RequestGenerator interface for seeded, batched request generation.
+ */
+
+#ifndef REQUESTGENERATOR_H
+#define REQUESTGENERATOR_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "Request.h"
+
+/**
+ * @class RequestGenerator
+ * @brief Produces random requests from an explicitly seeded, per-instance engine.
+ *
+ * fill() writes a batch of requests straight into a caller's array. The
+ * same name, seed and process-time bounds always yield the same sequence of
+ * requests.
+ *
+ * Built-in engines:
+ *  - xoshiro256: xoshiro256** run as four independent lanes, so the state
+ *    update is a fixed-width loop the compiler can vectorize;
+ *  - pcg32: PCG-XSH-RR with a 64-bit state, small and fast in scalar code;
+ *  - mt19937: the standard Mersenne Twister drawing each octet separately,
+ *    as Request::generateRandomRequest() does.
+ */
+class RequestGenerator {
+    protected:
+        int minTime;                  ///< Minimum generated processing time (inclusive)
+        int timeRange;                ///< Number of possible processing times
+
+        /**
+         * @brief Initializes the process-time bounds.
+         * @param minTime Minimum processing time (inclusive).
+         * @param maxTime Maximum processing time (inclusive).
+         */
+        RequestGenerator(int minTime, int maxTime);
+
+        /**
+         * @brief Builds a request from 64 bits of addresses and 32 bits of time and type.
+         *
+         * The process time takes the high bits of timeBits through a
+         * multiply-shift into [minTime, maxTime]; the job type takes the lowest bit.
+         */
+        Request makeRequest(uint64_t ipBits, uint32_t timeBits) const;
+
+    public:
+        virtual ~RequestGenerator();
+
+        /**
+         * @brief Writes count freshly generated requests to out.
+         * @param out Destination array with room for count requests.
+         * @param count Number of requests to generate.
+         */
+        virtual void fill(Request* out, int count) = 0;
+
+        /** @brief Returns the generator name as written in config.txt. */
+        virtual std::string getName() const = 0;
+
+        /**
+         * @brief Creates a generator by name.
+         * @param name Generator name: xoshiro256, pcg32 or mt19937.
+         * @param seed Seed for the engine.
+         * @param minTime Minimum processing time (inclusive).
+         * @param maxTime Maximum processing time (inclusive).
+         * @return The new generator, or nullptr if the name is unknown.
+         */
+        static std::unique_ptr<RequestGenerator> create(const std::string& name, uint64_t seed, int minTime, int maxTime);
+};
+
+#endif
@@ -4,35 +4,197 @@
  */
 
 #include "RequestQueue.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
-RequestQueue::RequestQueue() {
+static_assert(std::is_trivially_copyable<Request>::value, "the ring copies requests into raw storage");
 
+/**
+ * @brief Allocates uninitialized storage for a ring of requests.
+ * @param slots Number of requests the storage holds.
+ * @return The storage; its slots are written before they are read.
+ * @throws std::bad_alloc if the allocation fails.
+ */
+static Request* allocateRing(size_t slots){
+    void* storage = std::malloc(slots * sizeof(Request));
+    if (!storage) {
+        throw std::bad_alloc();
+    }
+    return static_cast<Request*>(storage);
+}
+
+RequestQueue::RequestQueue()
+    : buffer(allocateRing(initialCapacity)), head(0), count(0), mask(initialCapacity - 1), highWaterMark(0) {
+
+}
+
+void RequestQueue::grow(size_t minCapacity){
+    size_t oldCapacity = mask + 1;
+    size_t newCapacity = oldCapacity;
+    while (newCapacity < minCapacity) {
+        newCapacity *= 2;
+    }
+    // realloc can extend the block in place (or remap its pages), so the queued requests are not copied
+    void* grown = std::realloc(buffer.get(), newCapacity * sizeof(Request));
+    if (!grown) {
+        throw std::bad_alloc();
+    }
+    buffer.release();
+    buffer.reset(static_cast<Request*>(grown));
+    // the wrapped part [0, head + count - oldCapacity) moves up to follow the run that ends at oldCapacity
+    size_t firstRun = std::min(count, oldCapacity - head);
+    std::memcpy(buffer.get() + oldCapacity, buffer.get(), (count - firstRun) * sizeof(Request));
+    mask = newCapacity - 1;
+}
+
+void RequestQueue::reserve(int capacity){
+    if (capacity > 0 && static_cast<size_t>(capacity) > mask + 1) {
+        grow(capacity);
+    }
+}
+
+void RequestQueue::enableSpill(int highWaterMark, const std::string& directory, int segmentRequests){
+    this->highWaterMark = std::max(highWaterMark, 1);
+    reserve(this->highWaterMark);
+    spill.reset(new SpillStore(directory, segmentRequests));
+}
+
+int RequestQueue::spilledSize() const {
+    return spill ? spill->size() : 0;
+}
+
+void RequestQueue::refill(){
+    if (!spill || spill->size() == 0 || count > highWaterMark / 2) {
+        return;
+    }
+    // read straight into the free part of the ring, which wraps at most once
+    size_t wanted = std::min(highWaterMark - count, spill->size());
+    size_t tail = (head + count) & mask;
+    size_t firstRun = std::min(wanted, mask + 1 - tail);
+    count += spill->read(buffer.get() + tail, firstRun);
+    count += spill->read(buffer.get(), wanted - firstRun);
+}
+
+void RequestQueue::abandonSpill(){
+    std::cerr << "Failed to create a spill segment, keeping the request queue in memory" << std::endl;
+    std::unique_ptr<SpillStore> store = std::move(spill);
+    grow(count + store->size());
+    Request request;
+    while (store->read(&request, 1) == 1) {
+        buffer.get()[(head + count) & mask] = request;
+        count++;
+    }
+}
+
+bool RequestQueue::appendSpilled(const Request& request){
+    if (spill->size() > 0 || count >= highWaterMark) {
+        if (spill->append(request)) {
+            return true;
+        }
+        abandonSpill();
+    }
+    return false;
+}
+
+void RequestQueue::append(const Request& request){
+    // without spilling this is the only check the spill tier costs
+    if (spill && appendSpilled(request)) {
+        return;
+    }
+    if (count == mask + 1) {
+        grow(count + 1);
+    }
+    buffer.get()[(head + count) & mask] = request;
+    count++;
 }
 
 void RequestQueue::push(const Request& request){
-    queue.push(request);
+    append(request);
+}
+
+void RequestQueue::pushBatch(const Request* requests, int n){
+    if (n <= 0) {
+        return;
+    }
+    if (spill) {
+        for (int i = 0; i < n; i++) {
+            append(requests[i]);
+        }
+        return;
+    }
+    if (count + n > mask + 1) {
+        grow(count + n);
+    }
+    size_t tail = (head + count) & mask;
+    size_t firstRun = std::min(static_cast<size_t>(n), mask + 1 - tail);
+    std::memcpy(buffer.get() + tail, requests, firstRun * sizeof(Request));
+    std::memcpy(buffer.get(), requests + firstRun, (n - firstRun) * sizeof(Request));
+    count += n;
 }
 
 Request RequestQueue::pop(){
-    if (queue.empty()) {
+    if (count == 0) {
         throw std::runtime_error("Queue is empty");
     }
-    Request frontRequest = queue.front();
-    queue.pop();
+    Request frontRequest = buffer.get()[head];
+    head = (head + 1) & mask;
+    count--;
+    if (spill) {
+        refill();
+    }
     return frontRequest;
 }
 
+bool RequestQueue::tryPop(Request& out){
+    if (count == 0) {
+        return false;
+    }
+    out = buffer.get()[head];
+    head = (head + 1) & mask;
+    count--;
+    if (spill) {
+        refill();
+    }
+    return true;
+}
+
+int RequestQueue::popBatch(Request* out, int maxCount){
+    size_t done = 0;
+    size_t wanted = std::max(maxCount, 0);
+    // each pass empties at most the ring; refill() brings in the next stretch from the spill tier
+    while (done < wanted && count > 0) {
+        size_t n = std::min(count, wanted - done);
+        size_t firstRun = std::min(n, mask + 1 - head);
+        std::memcpy(out + done, buffer.get() + head, firstRun * sizeof(Request));
+        std::memcpy(out + done + firstRun, buffer.get(), (n - firstRun) * sizeof(Request));
+        head = (head + n) & mask;
+        count -= n;
+        done += n;
+        refill();
+    }
+    return done;
+}
+
 bool RequestQueue::isEmpty() const {
-    return queue.empty();
+    return count == 0;
 }
 
 int RequestQueue::size() const {
-    return queue.size();
+    return count + (spill ? spill->size() : 0);
+}
+
+int RequestQueue::capacity() const {
+    return mask + 1;
 }
 
-Request RequestQueue::front() const {
-    if (queue.empty()) {
+const Request& RequestQueue::front() const {
+    if (count == 0) {
         throw std::runtime_error("Queue is empty");
     }
-    return queue.front();
+    return buffer.get()[head];
 }
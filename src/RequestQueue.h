@@ -6,38 +6,148 @@
 #ifndef REQUESTQUEUE_H
 #define REQUESTQUEUE_H
 
-#include <queue>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <string>
 #include "Request.h"
+#include "SpillStore.h"
 
 /**
  * @class RequestQueue
  * @brief A FIFO queue that buffers incoming Request objects awaiting server assignment.
  *
- * Wraps std::queue<Request> with bounds-checked access and convenience methods
- * used by the LoadBalancer to manage pending requests.
+ * Requests live in a ring buffer whose capacity is a power of two, so the
+ * wrap-around is a mask rather than a division. The buffer doubles when it
+ * fills and never shrinks, so a queue that has reached its working size
+ * stops allocating. Batches are copied in and out as at most two contiguous
+ * runs. The ring is raw malloc storage: Request is trivially copyable, so
+ * growing reallocates the block in place where it can and only moves the
+ * wrapped part of the queue, instead of constructing and copying every slot.
+ *
+ * With spilling enabled the ring holds at most highWaterMark requests. Once
+ * it is full, later requests go to a SpillStore on disk, and keep going
+ * there while the store is non-empty, so FIFO order holds across both tiers.
+ * When the ring drains to half the mark it is topped up from the store.
+ * size() stays O(1) across both tiers.
  */
 class RequestQueue {
     private:
-        std::queue<Request> queue;  ///< Underlying standard queue of Request objects
+        /**
+         * @struct BufferDeleter
+         * @brief Releases ring storage obtained from malloc.
+         */
+        struct BufferDeleter {
+            void operator()(Request* storage) const { std::free(storage); }
+        };
+
+        std::unique_ptr<Request, BufferDeleter> buffer;  ///< Ring storage; its size is always a power of two
+        size_t head;                  ///< Index of the front request in buffer
+        size_t count;                 ///< Number of queued requests
+        size_t mask;                  ///< Ring size - 1
+        std::unique_ptr<SpillStore> spill;  ///< On-disk overflow tier, or null when spilling is disabled
+        size_t highWaterMark;         ///< Most requests kept in the ring while spilling is enabled
+
+        /**
+         * @brief Reallocates the ring so it holds at least minCapacity requests.
+         *
+         * Requests that had wrapped to the start of the ring are moved up past the old end, so FIFO order holds.
+         *
+         * @param minCapacity Required capacity.
+         */
+        void grow(size_t minCapacity);
+
+        /**
+         * @brief Tops the ring up from the spill tier once it has drained to half the high-water mark.
+         */
+        void refill();
+
+        /**
+         * @brief Moves every spilled request back into the ring and disables spilling.
+         *
+         * Used when the spill tier cannot create another segment file.
+         */
+        void abandonSpill();
+
+        /**
+         * @brief Appends a request to the ring or, once spilling has started, to the spill tier.
+         * @param request Request to enqueue.
+         */
+        void append(const Request& request);
+
+        /**
+         * @brief Sends a request to the spill tier if spilling has started or the ring is at the high-water mark.
+         *
+         * Requires spilling to be enabled.
+         *
+         * @param request Request to enqueue.
+         * @return true if the spill tier took the request, false if it belongs in the ring.
+         */
+        bool appendSpilled(const Request& request);
+
     public:
+        static const size_t initialCapacity = 64;  ///< Ring size of a new queue
+
         /**
          * @brief Default constructor. Creates an empty request queue.
          */
         RequestQueue();
 
+        /**
+         * @brief Grows the ring ahead of time so capacity requests fit without reallocating.
+         * @param capacity Number of requests the queue should hold.
+         */
+        void reserve(int capacity);
+
+        /**
+         * @brief Sends requests beyond highWaterMark to memory-mapped segment files on disk.
+         * @param highWaterMark Most requests kept in memory (at least 1).
+         * @param directory Directory for the segment files.
+         * @param segmentRequests Requests per segment file.
+         */
+        void enableSpill(int highWaterMark, const std::string& directory, int segmentRequests);
+
+        /**
+         * @brief Returns the number of requests currently held on disk.
+         * @return Spilled request count, 0 when spilling is disabled.
+         */
+        int spilledSize() const;
+
         /**
          * @brief Adds a request to the back of the queue.
          * @param request The Request to enqueue.
          */
         void push(const Request& request);
 
+        /**
+         * @brief Adds a batch of requests to the back of the queue, in order.
+         * @param requests Array of requests to enqueue.
+         * @param n Number of requests in the array.
+         */
+        void pushBatch(const Request* requests, int n);
+
         /**
          * @brief Removes and returns the request at the front of the queue.
-         * @return The oldest Request in the queue.
+         * @return The oldest Request in the queue, moved out of the ring.
          * @throws std::runtime_error if the queue is empty.
          */
         Request pop();
 
+        /**
+         * @brief Removes the request at the front of the queue if there is one.
+         * @param out Receives the oldest Request when the queue is not empty.
+         * @return true if a request was removed, false if the queue was empty.
+         */
+        bool tryPop(Request& out);
+
+        /**
+         * @brief Removes up to maxCount requests from the front of the queue, in order.
+         * @param out Array with room for maxCount requests.
+         * @param maxCount Largest number of requests to remove.
+         * @return Number of requests written to out.
+         */
+        int popBatch(Request* out, int maxCount);
+
         /**
          * @brief Checks whether the queue contains no requests.
          * @return true if the queue is empty, false otherwise.
@@ -50,12 +160,18 @@ class RequestQueue {
          */
         int size() const;
 
+        /**
+         * @brief Returns the number of requests the ring holds before it grows.
+         * @return Current capacity.
+         */
+        int capacity() const;
+
         /**
          * @brief Returns the request at the front of the queue without removing it.
-         * @return A copy of the front Request.
+         * @return The front Request.
          * @throws std::runtime_error if the queue is empty.
          */
-        Request front() const;
+        const Request& front() const;
 };
 
 #endif
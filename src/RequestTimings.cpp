@@ -0,0 +1,102 @@
+/**
+ * @file RequestTimings.cpp
+ * @brief Implementation of the RequestTimings class.
+ */
+
+#include "RequestTimings.h"
+#include <algorithm>
+
+int RequestTimings::typeIndex(char jobType) {
+    return jobType == 'S' ? 1 : 0;
+}
+
+bool RequestTimings::slower(const ServerTimings& a, const ServerTimings& b) {
+    // compare mean totals without dividing: a.totalSum / a.requests > b.totalSum / b.requests
+    long double left = static_cast<long double>(a.totalSum) * b.requests;
+    long double right = static_cast<long double>(b.totalSum) * a.requests;
+    if (left != right) {
+        return left > right;
+    }
+    return a.serverId < b.serverId;
+}
+
+void RequestTimings::recordStart(const Request& request, int cycle) {
+    int wait = cycle - request.getArrivalTime();
+    waits.record(wait);
+    typeWaits[typeIndex(request.getJobType())].record(wait);
+    intervalWaits.record(wait);
+}
+
+void RequestTimings::recordCompletion(const Request& request, int serverId, int cycle) {
+    int wait = request.getDispatchTime() - request.getArrivalTime();
+    int latency = cycle - request.getArrivalTime();
+
+    latencies.record(latency);
+    typeLatencies[typeIndex(request.getJobType())].record(latency);
+    intervalLatencies.record(latency);
+
+    ServerTimings& server = servers.emplace(serverId, ServerTimings{serverId, 0, 0, 0, 0, 0}).first->second;
+    server.requests++;
+    server.waitSum += wait;
+    server.totalSum += latency;
+    server.maxWait = std::max(server.maxWait, wait);
+    server.maxTotal = std::max(server.maxTotal, latency);
+}
+
+void RequestTimings::removeServer(int serverId) {
+    auto it = servers.find(serverId);
+    if (it == servers.end()) {
+        return;
+    }
+    const ServerTimings& removed = it->second;
+    if (static_cast<int>(slowestRemoved.size()) < keptServers) {
+        slowestRemoved.push_back(removed);
+    } else {
+        auto fastest = std::min_element(slowestRemoved.begin(), slowestRemoved.end(),
+                                        [](const ServerTimings& a, const ServerTimings& b) { return slower(b, a); });
+        if (slower(removed, *fastest)) {
+            *fastest = removed;
+        }
+    }
+    servers.erase(it);
+}
+
+const WaitStats& RequestTimings::getWaits() const {
+    return waits;
+}
+
+const WaitStats& RequestTimings::getLatencies() const {
+    return latencies;
+}
+
+const WaitStats& RequestTimings::getWaits(char jobType) const {
+    return typeWaits[typeIndex(jobType)];
+}
+
+const WaitStats& RequestTimings::getLatencies(char jobType) const {
+    return typeLatencies[typeIndex(jobType)];
+}
+
+std::vector<ServerTimings> RequestTimings::getSlowestServers(int n) const {
+    std::vector<ServerTimings> slowest = slowestRemoved;
+    for (const auto& entry : servers) {
+        slowest.push_back(entry.second);
+    }
+    n = std::max(0, std::min(n, static_cast<int>(slowest.size())));
+    std::partial_sort(slowest.begin(), slowest.begin() + n, slowest.end(), slower);
+    slowest.resize(n);
+    return slowest;
+}
+
+const WaitStats& RequestTimings::getIntervalWaits() const {
+    return intervalWaits;
+}
+
+const WaitStats& RequestTimings::getIntervalLatencies() const {
+    return intervalLatencies;
+}
+
+void RequestTimings::clearInterval() {
+    intervalWaits.clear();
+    intervalLatencies.clear();
+}
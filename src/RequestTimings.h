@@ -0,0 +1,123 @@
+/**
+ * @file RequestTimings.h
+ * @brief Declaration of the RequestTimings class, the queue wait and end-to-end latency histograms of requests.
+ */
+
+#ifndef REQUESTTIMINGS_H
+#define REQUESTTIMINGS_H
+
+#include <unordered_map>
+#include <vector>
+#include "Request.h"
+#include "WaitStats.h"
+
+/**
+ * @struct ServerTimings
+ * @brief Running totals of one server's completed requests.
+ */
+struct ServerTimings {
+    int serverId;           ///< Server the totals belong to
+    long long requests;     ///< Requests it completed
+    long long waitSum;      ///< Sum of their queue waits
+    long long totalSum;     ///< Sum of their end-to-end times
+    int maxWait;            ///< Longest queue wait
+    int maxTotal;           ///< Longest end-to-end time
+};
+
+/**
+ * @class RequestTimings
+ * @brief Queue wait and end-to-end latency, overall, per job type and per server.
+ *
+ * A request's wait (dispatch minus arrival) is recorded when it starts and
+ * its total time (completion minus arrival) when it completes, each into
+ * the overall and job-type histograms and into an interval histogram that
+ * the periodic status line reports and then clears. Histograms are
+ * WaitStats, so memory is bounded however long the run.
+ *
+ * Per server only fixed-size totals are kept, and only while the server
+ * exists: a removed server's totals are folded into a list of the
+ * slowest keptServers, so memory follows the live pool rather than every
+ * server ever created.
+ */
+class RequestTimings {
+    private:
+        static const int keptServers = 10;    ///< Removed servers remembered by getSlowestServers()
+
+        WaitStats waits;                      ///< Queue waits of all started requests
+        WaitStats latencies;                  ///< End-to-end times of all completed requests
+        WaitStats typeWaits[2];               ///< Queue waits by job type, 'P' then 'S'
+        WaitStats typeLatencies[2];           ///< End-to-end times by job type, 'P' then 'S'
+        WaitStats intervalWaits;              ///< Queue waits since the last clearInterval()
+        WaitStats intervalLatencies;          ///< End-to-end times since the last clearInterval()
+        std::unordered_map<int, ServerTimings> servers;   ///< Totals of live servers, by id
+        std::vector<ServerTimings> slowestRemoved;        ///< Slowest removed servers, at most keptServers
+
+        /** @brief Returns the slot of a job type in the per-type arrays. */
+        static int typeIndex(char jobType);
+
+        /**
+         * @brief Returns whether a server's requests took longer on average than another's.
+         * @param a First server's totals.
+         * @param b Second server's totals.
+         * @return true if a ranks before b among the slowest.
+         */
+        static bool slower(const ServerTimings& a, const ServerTimings& b);
+
+    public:
+        /**
+         * @brief Records a request starting on a server.
+         * @param request Request, stamped with its arrival cycle.
+         * @param cycle Clock cycle it started.
+         */
+        void recordStart(const Request& request, int cycle);
+
+        /**
+         * @brief Records a completed request.
+         * @param request Completed request, stamped with its arrival and dispatch cycles.
+         * @param serverId Id of the server that processed it.
+         * @param cycle Clock cycle of the completion.
+         */
+        void recordCompletion(const Request& request, int serverId, int cycle);
+
+        /**
+         * @brief Drops a removed server's totals, remembering them if they rank among the slowest.
+         * @param serverId Id of the removed server.
+         */
+        void removeServer(int serverId);
+
+        /** @brief Returns the queue waits of all started requests. */
+        const WaitStats& getWaits() const;
+
+        /** @brief Returns the end-to-end times of all completed requests. */
+        const WaitStats& getLatencies() const;
+
+        /**
+         * @brief Returns the queue waits of one job type.
+         * @param jobType 'P' or 'S'.
+         */
+        const WaitStats& getWaits(char jobType) const;
+
+        /**
+         * @brief Returns the end-to-end times of one job type.
+         * @param jobType 'P' or 'S'.
+         */
+        const WaitStats& getLatencies(char jobType) const;
+
+        /**
+         * @brief Returns the servers, live or removed, with the longest mean end-to-end time.
+         * @param n Most servers to return (removed ones are only remembered up to keptServers).
+         * @return Up to n servers, slowest first.
+         */
+        std::vector<ServerTimings> getSlowestServers(int n) const;
+
+        /** @brief Returns the queue waits since the last clearInterval(). */
+        const WaitStats& getIntervalWaits() const;
+
+        /** @brief Returns the end-to-end times since the last clearInterval(). */
+        const WaitStats& getIntervalLatencies() const;
+
+        /** @brief Starts a new status interval. */
+        void clearInterval();
+};
+
+#endif
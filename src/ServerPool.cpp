@@ -0,0 +1,281 @@
+/**
+ * @file ServerPool.cpp
+ * @brief Implementation of the ServerPool class.
+ */
+
+#include "ServerPool.h"
+#include <algorithm>
+#include <cstring>
+
+ServerPool::ServerPool(bool trackCompletions, int localQueueSize, bool trackLoad)
+    : localQueueSize(std::max(localQueueSize, 0)), localTotal(0),
+      trackCompletions(trackCompletions), trackLoad(trackLoad) {
+}
+
+void ServerPool::start(int slot, const Request& request, int currTime) {
+    int duration = std::max(request.getProcessTime(), 1);
+    requests[slot] = request;
+    requests[slot].setDispatchTime(currTime);
+    busy[slot] = 1;
+    timeRemaining[slot] = duration;
+    finishTime[slot] = currTime + duration;
+
+    if (trackCompletions) {
+        completions.push(slot, finishTime[slot]);
+    }
+}
+
+void ServerPool::removeFromIdle(int slot) {
+    int i = idlePos[slot];
+    int last = idle.back();
+    idle[i] = last;
+    idlePos[last] = i;
+    idle.pop_back();
+    idlePos[slot] = -1;
+}
+
+void ServerPool::moveSlot(int from, int to) {
+    ids[to] = ids[from];
+    busy[to] = busy[from];
+    timeRemaining[to] = timeRemaining[from];
+    finishTime[to] = finishTime[from];
+    drainTime[to] = drainTime[from];
+    requests[to] = requests[from];
+
+    localHead[to] = localHead[from];
+    localCount[to] = localCount[from];
+    for (int i = 0; i < localQueueSize; i++) {
+        localItems[to * localQueueSize + i] = localItems[from * localQueueSize + i];
+    }
+
+    idlePos[to] = idlePos[from];
+    if (idlePos[to] >= 0) {
+        idle[idlePos[to]] = to;
+    }
+    completions.moveSlot(from, to);
+    load.moveSlot(from, to);
+}
+
+int ServerPool::add(int serverId) {
+    int slot = ids.size();
+    ids.push_back(serverId);
+    busy.push_back(0);
+    timeRemaining.push_back(0);
+    finishTime.push_back(0);
+    drainTime.push_back(0);
+    requests.push_back(Request());
+
+    localHead.push_back(0);
+    localCount.push_back(0);
+    localItems.resize(localItems.size() + localQueueSize);
+
+    idlePos.push_back(idle.size());
+    idle.push_back(slot);
+
+    completions.resize(slot + 1);
+    load.resize(slot + 1);
+    if (trackLoad) {
+        load.push(slot, 0);
+    }
+    return slot;
+}
+
+int ServerPool::removeIdle() {
+    if (idle.empty()) {
+        return -1;
+    }
+    int slot = idle.back();
+    idle.pop_back();
+    idlePos[slot] = -1;
+    load.remove(slot);
+    int serverId = ids[slot];
+
+    int last = ids.size() - 1;
+    if (slot != last) {
+        moveSlot(last, slot);
+    }
+    ids.pop_back();
+    busy.pop_back();
+    timeRemaining.pop_back();
+    finishTime.pop_back();
+    drainTime.pop_back();
+    requests.pop_back();
+    localHead.pop_back();
+    localCount.pop_back();
+    localItems.resize(localItems.size() - localQueueSize);
+    idlePos.pop_back();
+    completions.resize(last);
+    load.resize(last);
+    return serverId;
+}
+
+int ServerPool::acquireIdle() {
+    if (idle.empty()) {
+        return -1;
+    }
+    int slot = idle.back();
+    idle.pop_back();
+    idlePos[slot] = -1;
+    return slot;
+}
+
+int ServerPool::peekIdle() const {
+    return idle.empty() ? -1 : idle.back();
+}
+
+void ServerPool::assign(int slot, const Request& request, int currTime) {
+    start(slot, request, currTime);
+    drainTime[slot] = finishTime[slot];
+    if (trackLoad) {
+        load.push(slot, drainTime[slot]);
+    }
+}
+
+int ServerPool::assignIdle(const Request* requests, int* slots, int count, int currTime) {
+    int started = std::min(count, static_cast<int>(idle.size()));
+    for (int i = 0; i < started; i++) {
+        int slot = idle.back();
+        idle.pop_back();
+        idlePos[slot] = -1;
+        assign(slot, requests[i], currTime);
+        slots[i] = slot;
+    }
+    return started;
+}
+
+bool ServerPool::enqueue(int slot, const Request& request, int currTime) {
+    if (!busy[slot]) {
+        removeFromIdle(slot);
+        assign(slot, request, currTime);
+        return true;
+    }
+
+    int tail = (localHead[slot] + localCount[slot]) % localQueueSize;
+    localItems[slot * localQueueSize + tail] = request;
+    localCount[slot]++;
+    localTotal++;
+
+    drainTime[slot] += std::max(request.getProcessTime(), 1);
+    if (trackLoad) {
+        load.push(slot, drainTime[slot]);
+    }
+    return false;
+}
+
+/**
+ * @brief Decrements one block of busy servers and flags those that finished.
+ *
+ * The fixed trip count and restrict-qualified pointers let the compiler emit a
+ * straight SIMD decrement-and-compare at -O2 without aliasing checks or a
+ * scalar epilogue.
+ */
+static void advanceBlock(int32_t* __restrict remaining, const uint8_t* __restrict active, uint8_t* __restrict done) {
+    for (int j = 0; j < 64; j++) {
+        int32_t left = remaining[j] - active[j];
+        remaining[j] = left;
+        done[j] = active[j] & (left <= 0);
+    }
+}
+
+int ServerPool::advanceClockCycle(std::vector<uint64_t>& completedMask) {
+    int n = ids.size();
+    completedMask.assign((n + 63) / 64, 0);
+
+    int32_t* remaining = timeRemaining.data();
+    const uint8_t* active = busy.data();
+    uint8_t done[64];
+    int completed = 0;
+
+    for (int base = 0; base < n; base += 64) {
+        int count = n - base;
+        if (count >= 64) {
+            advanceBlock(remaining + base, active + base, done);
+        } else {
+            std::memset(done, 0, sizeof(done));
+            for (int j = 0; j < count; j++) {
+                int32_t left = remaining[base + j] - active[base + j];
+                remaining[base + j] = left;
+                done[j] = active[base + j] & (left <= 0);
+            }
+        }
+
+        // most blocks finish nothing this cycle, so test eight flags at a time
+        uint64_t word = 0;
+        for (int j = 0; j < 64; j += 8) {
+            uint64_t chunk;
+            std::memcpy(&chunk, done + j, sizeof(chunk));
+            if (chunk == 0) {
+                continue;
+            }
+            for (int k = 0; k < 8; k++) {
+                word |= static_cast<uint64_t>(done[j + k]) << (j + k);
+            }
+        }
+        completedMask[base / 64] = word;
+        completed += __builtin_popcountll(word);
+    }
+    return completed;
+}
+
+int ServerPool::popCompleted(int currTime) {
+    if (completions.isEmpty() || completions.topKey() > currTime) {
+        return -1;
+    }
+    return completions.pop();
+}
+
+bool ServerPool::release(int slot, int currTime) {
+    if (localCount[slot] > 0) {
+        const Request& next = localItems[slot * localQueueSize + localHead[slot]];
+        localHead[slot] = (localHead[slot] + 1) % localQueueSize;
+        localCount[slot]--;
+        localTotal--;
+        start(slot, next, currTime);
+        return true;
+    }
+
+    busy[slot] = 0;
+    timeRemaining[slot] = 0;
+    idlePos[slot] = idle.size();
+    idle.push_back(slot);
+    return false;
+}
+
+int ServerPool::nextCompletionTime() const {
+    if (completions.isEmpty()) {
+        return -1;
+    }
+    return completions.topKey();
+}
+
+int ServerPool::leastLoaded() const {
+    return load.top();
+}
+
+int ServerPool::getServerId(int slot) const {
+    return ids[slot];
+}
+
+const Request& ServerPool::getRequest(int slot) const {
+    return requests[slot];
+}
+
+bool ServerPool::hasRoom(int slot) const {
+    return !busy[slot] || localCount[slot] < localQueueSize;
+}
+
+int ServerPool::getOutstanding(int slot) const {
+    return busy[slot] + localCount[slot];
+}
+
+int ServerPool::size() const {
+    return ids.size();
+}
+
+int ServerPool::idleCount() const {
+    return idle.size();
+}
+
+int ServerPool::localQueuedCount() const {
+    return localTotal;
+}
@@ -0,0 +1,232 @@
+/**
+ * @file ServerPool.h
+ * @brief Declaration of the ServerPool class that stores and indexes the web servers.
+ */
+
+#ifndef SERVERPOOL_H
+#define SERVERPOOL_H
+
+#include <cstdint>
+#include <vector>
+#include "IndexedHeap.h"
+#include "Request.h"
+
+/**
+ * @class ServerPool
+ * @brief Contiguous struct-of-arrays pool of web servers.
+ *
+ * Each server occupies a slot; its ID, busy flag, remaining time, finish cycle
+ * and current request live at that index in separate arrays, so a pass over
+ * one field touches only that field's cache lines. Slots stay dense: removing
+ * a server moves the last slot into the hole.
+ *
+ * Every server may also hold a small fixed-capacity local queue of requests it
+ * will start, in order, as soon as its current one finishes. Idle servers
+ * always have an empty local queue.
+ *
+ * Idle slots are kept on a free list so acquiring or removing an idle server is
+ * O(1). Completions are found in one of two ways:
+ *  - advanceClockCycle() decrements every busy server in a single branch-free
+ *    pass that the compiler vectorizes, and returns a bitmask of finished slots
+ *    (used by the per-cycle loop);
+ *  - when completion tracking is enabled, busy slots are also kept in an
+ *    IndexedHeap keyed on finish cycle, so popCompleted() and
+ *    nextCompletionTime() cost O(log n) and O(1) (used by the event loop).
+ *
+ * When load tracking is enabled, every slot is kept in a second IndexedHeap
+ * keyed on the cycle it will have drained all assigned work, which gives
+ * leastLoaded() in O(1).
+ */
+class ServerPool {
+    private:
+        std::vector<int> ids;               ///< Server ID per slot
+        std::vector<uint8_t> busy;          ///< 1 if the slot is processing a request, 0 if idle
+        std::vector<int32_t> timeRemaining; ///< Cycles left on the current request (advanced by advanceClockCycle)
+        std::vector<int> finishTime;        ///< Cycle on which the current request completes
+        std::vector<int> drainTime;         ///< Cycle on which the current request and local queue are all done
+        std::vector<Request> requests;      ///< Request currently held by each slot
+
+        int localQueueSize;                 ///< Capacity of each slot's local queue
+        std::vector<int> localHead;         ///< Index of the oldest local request within the slot's ring
+        std::vector<int> localCount;        ///< Number of requests in the slot's local queue
+        std::vector<Request> localItems;    ///< Local queue rings, localQueueSize entries per slot
+        int localTotal;                     ///< Sum of localCount over all slots
+
+        std::vector<int> idle;              ///< Free list of idle slots (LIFO)
+        std::vector<int> idlePos;           ///< Position of each slot in idle, or -1
+
+        bool trackCompletions;              ///< Whether busy slots are kept in the completion heap
+        IndexedHeap completions;            ///< Busy slots ordered by finish cycle
+        bool trackLoad;                     ///< Whether every slot is kept in the load heap
+        IndexedHeap load;                   ///< All slots ordered by drain cycle
+
+        /**
+         * @brief Starts processing a request on a slot, stamping its dispatch cycle, without touching its drain time.
+         */
+        void start(int slot, const Request& request, int currTime);
+
+        /**
+         * @brief Takes a slot off the idle free list in O(1).
+         */
+        void removeFromIdle(int slot);
+
+        /**
+         * @brief Moves every field of slot from into slot to, fixing up the free list and heap indices.
+         */
+        void moveSlot(int from, int to);
+
+    public:
+        /**
+         * @brief Constructs an empty pool.
+         * @param trackCompletions If true, busy slots are kept in the completion heap.
+         * @param localQueueSize Capacity of each server's local queue (0 for none).
+         * @param trackLoad If true, slots are kept in the load heap used by leastLoaded().
+         */
+        explicit ServerPool(bool trackCompletions = false, int localQueueSize = 0, bool trackLoad = false);
+
+        /**
+         * @brief Adds an idle server to the pool.
+         * @param serverId Unique ID for the new server.
+         * @return Slot of the new server.
+         */
+        int add(int serverId);
+
+        /**
+         * @brief Removes one idle server from the pool.
+         * @return ID of the removed server, or -1 if no server is idle.
+         */
+        int removeIdle();
+
+        /**
+         * @brief Takes an idle slot off the free list.
+         *
+         * The caller must hand the slot a request with assign().
+         *
+         * @return An idle slot, or -1 if none is idle.
+         */
+        int acquireIdle();
+
+        /**
+         * @brief Returns an idle slot without taking it off the free list.
+         * @return An idle slot, or -1 if none is idle.
+         */
+        int peekIdle() const;
+
+        /**
+         * @brief Assigns a request to a slot taken from acquireIdle().
+         *
+         * The request completes max(processTime, 1) cycles after currTime.
+         *
+         * @param slot Slot to assign the request to.
+         * @param request Request to process.
+         * @param currTime Current simulation clock cycle.
+         */
+        void assign(int slot, const Request& request, int currTime);
+
+        /**
+         * @brief Starts a batch of requests on idle servers, in acquireIdle() order.
+         * @param requests Requests to start.
+         * @param slots Output array receiving the slot each request was assigned to.
+         * @param count Number of requests; at most idleCount().
+         * @param currTime Current simulation clock cycle.
+         * @return Number of requests started.
+         */
+        int assignIdle(const Request* requests, int* slots, int count, int currTime);
+
+        /**
+         * @brief Hands a request to a server, starting it now if the server is idle.
+         *
+         * Otherwise the request is appended to the server's local queue; the
+         * caller must check hasRoom() first.
+         *
+         * @param slot Slot to send the request to.
+         * @param request Request to process.
+         * @param currTime Current simulation clock cycle.
+         * @return true if the request started immediately, false if it was queued locally.
+         */
+        bool enqueue(int slot, const Request& request, int currTime);
+
+        /**
+         * @brief Advances every busy server by one clock cycle.
+         *
+         * Runs one decrement-and-compare pass over the busy and timeRemaining
+         * arrays. Bit (slot % 64) of completedMask[slot / 64] is set for every
+         * slot whose request just finished; those slots stay busy until release().
+         *
+         * @param completedMask Output bitmask, resized to cover every slot.
+         * @return Number of completed slots.
+         */
+        int advanceClockCycle(std::vector<uint64_t>& completedMask);
+
+        /**
+         * @brief Pops the next slot whose request completes on or before the given cycle.
+         *
+         * Requires completion tracking. The slot stays busy until release().
+         *
+         * @param currTime Current simulation clock cycle.
+         * @return A slot with a completed request, or -1 if none is due.
+         */
+        int popCompleted(int currTime);
+
+        /**
+         * @brief Retires a slot's completed request.
+         *
+         * If the slot's local queue holds a request it starts immediately;
+         * otherwise the slot goes idle and back on the free list.
+         *
+         * @param slot Slot to release.
+         * @param currTime Current simulation clock cycle.
+         * @return true if the next local request was started, false if the slot went idle.
+         */
+        bool release(int slot, int currTime);
+
+        /**
+         * @brief Returns the earliest cycle on which a busy server completes.
+         *
+         * Requires completion tracking.
+         *
+         * @return Next completion cycle, or -1 if no server is busy.
+         */
+        int nextCompletionTime() const;
+
+        /**
+         * @brief Returns the slot that will finish its assigned work soonest.
+         *
+         * Requires load tracking.
+         *
+         * @return Least-loaded slot, or -1 if the pool is empty.
+         */
+        int leastLoaded() const;
+
+        /** @brief Returns the server ID stored in a slot. */
+        int getServerId(int slot) const;
+
+        /** @brief Returns the request currently held by a slot. */
+        const Request& getRequest(int slot) const;
+
+        /** @brief Returns true if the slot can accept another request via enqueue(). */
+        bool hasRoom(int slot) const;
+
+        /** @brief Returns the number of requests the slot is processing or holding locally. */
+        int getOutstanding(int slot) const;
+
+        /**
+         * @brief Returns the number of servers in the pool.
+         * @return Server count.
+         */
+        int size() const;
+
+        /**
+         * @brief Returns the number of idle servers.
+         * @return Idle server count.
+         */
+        int idleCount() const;
+
+        /**
+         * @brief Returns the number of requests held in local queues across all servers.
+         * @return Locally queued request count.
+         */
+        int localQueuedCount() const;
+};
+
+#endif
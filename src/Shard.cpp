@@ -0,0 +1,72 @@
+/**
+ * @file Shard.cpp
+ * @brief Implementation of the Shard class.
+ */
+
+#include "Shard.h"
+#include <algorithm>
+
+Shard::Shard() : nextArrival(0) {
+}
+
+ServerPool& Shard::getServers() {
+    return servers;
+}
+
+const ServerPool& Shard::getServers() const {
+    return servers;
+}
+
+RequestQueue& Shard::getQueue() {
+    return queue;
+}
+
+const RequestQueue& Shard::getQueue() const {
+    return queue;
+}
+
+void Shard::addArrival(int cycle, const Request& request) {
+    arrivals.push_back(std::make_pair(cycle, request));
+}
+
+void Shard::runCycles(int fromTime, int toTime) {
+    for (int cycle = fromTime; cycle < toTime; cycle++) {
+        while (nextArrival < arrivals.size() && arrivals[nextArrival].first <= cycle) {
+            queue.push(arrivals[nextArrival].second);
+            nextArrival++;
+        }
+
+        if (servers.advanceClockCycle(completedMask) > 0) {
+            for (size_t word = 0; word < completedMask.size(); word++) {
+                uint64_t bits = completedMask[word];
+                while (bits != 0) {
+                    int slot = word * 64 + __builtin_ctzll(bits);
+                    entries.push_back(ShardLogEntry{cycle, false, servers.getServerId(slot), servers.getRequest(slot)});
+                    servers.release(slot, cycle);
+                    bits &= bits - 1;
+                }
+            }
+        }
+
+        int count = std::min(queue.size(), servers.idleCount());
+        if (count > 0) {
+            dispatchBatch.resize(count);
+            dispatchSlots.resize(count);
+            queue.popBatch(dispatchBatch.data(), count);
+            servers.assignIdle(dispatchBatch.data(), dispatchSlots.data(), count, cycle);
+            for (int i = 0; i < count; i++) {
+                entries.push_back(ShardLogEntry{cycle, true, servers.getServerId(dispatchSlots[i]), dispatchBatch[i]});
+            }
+        }
+    }
+}
+
+const std::vector<ShardLogEntry>& Shard::getEntries() const {
+    return entries;
+}
+
+void Shard::clearEntries() {
+    entries.clear();
+    arrivals.clear();
+    nextArrival = 0;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file Shard.h
+ * @brief Declaration of the Shard class, one partition of the server pool in parallel mode.
+ */
+
+#ifndef SHARD_H
+#define SHARD_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Request.h"
+#include "RequestQueue.h"
+#include "ServerPool.h"
+
+/**
+ * @struct ShardLogEntry
+ * @brief A request start or completion recorded by a shard for later logging.
+ *
+ * Shards never touch the LogFile directly; the coordinating thread replays
+ * these entries in a fixed order at each barrier so the log is deterministic.
+ */
+struct ShardLogEntry {
+    int cycle;          ///< Clock cycle of the event
+    bool started;       ///< true for a request start, false for a completion
+    int serverId;       ///< Server that started or finished the request
+    Request request;    ///< The request involved
+};
+
+/**
+ * @class Shard
+ * @brief A slice of the server pool with its own local request queue.
+ *
+ * Between barriers a shard runs the per-cycle steps (accept arrivals, advance
+ * servers, dispatch) using only its own state, so shards can run on separate
+ * threads without locking. Rebalancing, scaling and logging happen on the
+ * coordinating thread while every shard is parked at the barrier.
+ */
+class Shard {
+    private:
+        ServerPool servers;                              ///< Servers owned by this shard
+        RequestQueue queue;                              ///< Local FIFO of requests waiting for this shard
+        std::vector<uint64_t> completedMask;             ///< Scratch bitmask for advanceClockCycle()
+        std::vector<std::pair<int, Request>> arrivals;   ///< Requests routed here for the current epoch, by cycle
+        size_t nextArrival;                              ///< Index of the next arrival to enqueue
+        std::vector<ShardLogEntry> entries;              ///< Starts and completions recorded this epoch
+        std::vector<Request> dispatchBatch;              ///< Scratch buffer for the requests started together
+        std::vector<int> dispatchSlots;                  ///< Slots that received dispatchBatch, in the same order
+
+    public:
+        /**
+         * @brief Default constructor. Creates a shard with no servers.
+         */
+        Shard();
+
+        /** @brief Returns the shard's server pool. */
+        ServerPool& getServers();
+
+        /** @brief Returns the shard's server pool (read-only). */
+        const ServerPool& getServers() const;
+
+        /** @brief Returns the shard's local request queue. */
+        RequestQueue& getQueue();
+
+        /** @brief Returns the shard's local request queue (read-only). */
+        const RequestQueue& getQueue() const;
+
+        /**
+         * @brief Routes a request to this shard, to be enqueued at the given cycle.
+         *
+         * Arrivals must be added in non-decreasing cycle order.
+         *
+         * @param cycle Clock cycle at which the request arrives.
+         * @param request The arriving request.
+         */
+        void addArrival(int cycle, const Request& request);
+
+        /**
+         * @brief Simulates the clock cycles [fromTime, toTime) on this shard.
+         * @param fromTime First cycle to simulate.
+         * @param toTime One past the last cycle to simulate.
+         */
+        void runCycles(int fromTime, int toTime);
+
+        /**
+         * @brief Returns the starts and completions recorded since the last clearEntries().
+         *
+         * Entries are ordered by cycle; within a cycle all completions precede all starts.
+         */
+        const std::vector<ShardLogEntry>& getEntries() const;
+
+        /**
+         * @brief Discards recorded entries and consumed arrivals.
+         */
+        void clearEntries();
+};
+
+#endif
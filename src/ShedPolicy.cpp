@@ -0,0 +1,149 @@
+/**
+ * @file ShedPolicy.cpp
+ * @brief Implementation of the built-in admission control policies.
+ */
+
+#include "ShedPolicy.h"
+#include "Request.h"
+#include <algorithm>
+#include <cmath>
+
+ShedPolicy::ShedPolicy(int maxDepth) : maxDepth(std::max(maxDepth, 0)) {
+}
+
+ShedPolicy::~ShedPolicy() {
+}
+
+ShedAction ShedPolicy::onArrival(int queueSize) {
+    if (maxDepth > 0 && queueSize >= maxDepth) {
+        return ShedAction::DropArrival;
+    }
+    return ShedAction::Admit;
+}
+
+bool ShedPolicy::onDequeue(int sojourn, int queueSize, int currTime) {
+    (void)sojourn;
+    (void)queueSize;
+    (void)currTime;
+    return false;
+}
+
+bool ShedPolicy::shedsOnDequeue() const {
+    return false;
+}
+
+int ShedPolicy::getMaxDepth() const {
+    return maxDepth;
+}
+
+std::unique_ptr<ShedPolicy> ShedPolicy::create(const std::string& name, const Config& config, unsigned int seed) {
+    int maxDepth = std::max(config.getMaxQueueDepth(), 0);
+    long long budget = config.getQueueMemoryBudget();
+    if (budget > 0) {
+        long long budgetDepth = std::max(budget / static_cast<long long>(sizeof(Request)), 1LL);
+        if (maxDepth == 0 || budgetDepth < maxDepth) {
+            maxDepth = static_cast<int>(std::min<long long>(budgetDepth, 0x7fffffff));
+        }
+    }
+
+    if (name == "drop-tail") {
+        return std::unique_ptr<ShedPolicy>(new DropTailPolicy(maxDepth));
+    } else if (name == "drop-oldest") {
+        return std::unique_ptr<ShedPolicy>(new DropOldestPolicy(maxDepth));
+    } else if (name == "codel") {
+        return std::unique_ptr<ShedPolicy>(new CodelPolicy(maxDepth, config.getCodelTarget(), config.getCodelInterval()));
+    } else if (name == "red") {
+        return std::unique_ptr<ShedPolicy>(new RedPolicy(maxDepth, config.getRedMinFraction(), seed));
+    }
+    return nullptr;
+}
+
+DropTailPolicy::DropTailPolicy(int maxDepth) : ShedPolicy(maxDepth) {
+}
+
+std::string DropTailPolicy::getName() const {
+    return "drop-tail";
+}
+
+DropOldestPolicy::DropOldestPolicy(int maxDepth) : DropTailPolicy(maxDepth) {
+}
+
+ShedAction DropOldestPolicy::onArrival(int queueSize) {
+    if (maxDepth > 0 && queueSize >= maxDepth) {
+        return ShedAction::DropOldest;
+    }
+    return ShedAction::Admit;
+}
+
+std::string DropOldestPolicy::getName() const {
+    return "drop-oldest";
+}
+
+CodelPolicy::CodelPolicy(int maxDepth, int target, int interval)
+    : ShedPolicy(maxDepth), target(std::max(target, 0)), interval(std::max(interval, 1)),
+      firstAboveTime(-1), dropping(false), dropNext(0), count(0), lastCount(0) {
+}
+
+bool CodelPolicy::onDequeue(int sojourn, int queueSize, int currTime) {
+    bool okToDrop = false;
+    // a queue this short drains within one request, so its wait is not a standing queue
+    if (sojourn < target || queueSize == 0) {
+        firstAboveTime = -1;
+    } else if (firstAboveTime < 0) {
+        firstAboveTime = currTime + interval;
+    } else if (currTime >= firstAboveTime) {
+        okToDrop = true;
+    }
+
+    if (dropping) {
+        if (!okToDrop) {
+            dropping = false;
+            return false;
+        }
+        if (currTime >= dropNext) {
+            count++;
+            dropNext += static_cast<int>(interval / std::sqrt(static_cast<double>(count)));
+            return true;
+        }
+        return false;
+    }
+
+    if (!okToDrop) {
+        return false;
+    }
+    dropping = true;
+    // re-entering soon after the last dropping state resumes near the drop rate it had reached
+    int delta = count - lastCount;
+    count = (delta > 1 && currTime - dropNext < 16 * interval) ? delta : 1;
+    lastCount = count;
+    dropNext = currTime + static_cast<int>(interval / std::sqrt(static_cast<double>(count)));
+    return true;
+}
+
+bool CodelPolicy::shedsOnDequeue() const {
+    return true;
+}
+
+std::string CodelPolicy::getName() const {
+    return "codel";
+}
+
+RedPolicy::RedPolicy(int maxDepth, double minFraction, unsigned int seed)
+    : ShedPolicy(maxDepth), rng(seed), unit(0.0, 1.0) {
+    minDepth = static_cast<int>(maxDepth * std::min(std::max(minFraction, 0.0), 1.0));
+}
+
+ShedAction RedPolicy::onArrival(int queueSize) {
+    if (maxDepth == 0 || queueSize < minDepth) {
+        return ShedAction::Admit;
+    }
+    if (queueSize >= maxDepth) {
+        return ShedAction::DropArrival;
+    }
+    double dropProbability = static_cast<double>(queueSize - minDepth + 1) / (maxDepth - minDepth + 1);
+    return unit(rng) < dropProbability ? ShedAction::DropArrival : ShedAction::Admit;
+}
+
+std::string RedPolicy::getName() const {
+    return "red";
+}
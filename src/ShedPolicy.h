@@ -0,0 +1,163 @@
+/**
+ * @file ShedPolicy.h
+ * @brief Declaration of the ShedPolicy interface and the built-in admission control policies.
+ */
+
+#ifndef SHEDPOLICY_H
+#define SHEDPOLICY_H
+
+#include <memory>
+#include <random>
+#include <string>
+#include "Config.h"
+
+/**
+ * @enum ShedAction
+ * @brief What to do with a request arriving at the queue.
+ */
+enum class ShedAction {
+    Admit,        ///< Queue the request
+    DropArrival,  ///< Shed the arriving request
+    DropOldest    ///< Shed the request at the head of the queue, then queue the arrival
+};
+
+/**
+ * @class ShedPolicy
+ * @brief Admission control for the central request queue.
+ *
+ * Every policy enforces the same hard depth limit: maxQueueDepth requests,
+ * or as many as fit in queueMemoryBudget bytes if that is smaller (0 leaves
+ * either unlimited). Below the limit, policies may also shed early: when a
+ * request arrives (onArrival()) or when it is taken off the queue to start
+ * (onDequeue()). A bounded queue bounds the wait of every request it admits
+ * by roughly limit * meanServiceTime / servers cycles.
+ */
+class ShedPolicy {
+    protected:
+        int maxDepth;   ///< Hard queue depth limit, or 0 for unbounded
+
+        /**
+         * @brief Sets the hard depth limit.
+         * @param maxDepth Queue depth limit, or 0 for unbounded.
+         */
+        explicit ShedPolicy(int maxDepth);
+
+    public:
+        virtual ~ShedPolicy();
+
+        /**
+         * @brief Decides what happens to a request arriving at the queue.
+         *
+         * The default sheds the arrival once the queue is at the hard limit.
+         *
+         * @param queueSize Requests already in the queue.
+         * @return Action to take.
+         */
+        virtual ShedAction onArrival(int queueSize);
+
+        /**
+         * @brief Decides whether a request leaving the queue should be shed instead of started.
+         * @param sojourn Cycles the request spent in the queue.
+         * @param queueSize Requests left in the queue after this one.
+         * @param currTime Current simulation clock cycle.
+         * @return true to shed the request. The default never sheds here.
+         */
+        virtual bool onDequeue(int sojourn, int queueSize, int currTime);
+
+        /** @brief Returns true if onDequeue() can shed, so every dequeue must be checked. */
+        virtual bool shedsOnDequeue() const;
+
+        /** @brief Returns the policy name as written in config.txt. */
+        virtual std::string getName() const = 0;
+
+        /** @brief Returns the hard queue depth limit, or 0 if the queue is unbounded. */
+        int getMaxDepth() const;
+
+        /**
+         * @brief Creates a policy by name.
+         *
+         * Known names: drop-tail, drop-oldest, codel, red.
+         *
+         * @param name Policy name.
+         * @param config Configuration providing the depth limits and the policy's parameters.
+         * @param seed Seed for policies that make random choices.
+         * @return The new policy, or nullptr if the name is unknown.
+         */
+        static std::unique_ptr<ShedPolicy> create(const std::string& name, const Config& config, unsigned int seed);
+};
+
+/**
+ * @class DropTailPolicy
+ * @brief Sheds arrivals while the queue is full.
+ *
+ * With no depth limit configured this is the original unbounded queue.
+ */
+class DropTailPolicy : public ShedPolicy {
+    public:
+        explicit DropTailPolicy(int maxDepth);
+        std::string getName() const override;
+};
+
+/**
+ * @class DropOldestPolicy
+ * @brief Sheds the head of the queue to make room for each arrival while the queue is full.
+ *
+ * Keeps the freshest requests, which suits work whose value decays with age.
+ */
+class DropOldestPolicy : public DropTailPolicy {
+    public:
+        explicit DropOldestPolicy(int maxDepth);
+        ShedAction onArrival(int queueSize) override;
+        std::string getName() const override;
+};
+
+/**
+ * @class CodelPolicy
+ * @brief Controlled-delay dropping based on how long requests sat in the queue.
+ *
+ * Follows CoDel (RFC 8289) with clock cycles for time. Once every request
+ * leaving the queue for codelInterval cycles has waited at least
+ * codelTarget cycles, the policy enters a dropping state and sheds one
+ * dequeued request, then the next after interval / sqrt(count) cycles, and
+ * so on, until a request leaves with a wait below the target. The hard depth
+ * limit still sheds arrivals as drop-tail does.
+ */
+class CodelPolicy : public ShedPolicy {
+    private:
+        int target;           ///< Acceptable standing queue wait in cycles
+        int interval;         ///< Cycles the wait must stay above target before dropping starts
+        int firstAboveTime;   ///< Cycle at which dropping may start, or -1 while the wait is below target
+        bool dropping;        ///< True while in the dropping state
+        int dropNext;         ///< Cycle of the next drop in the dropping state
+        int count;            ///< Drops since entering the dropping state
+        int lastCount;        ///< count when the previous dropping state began
+
+    public:
+        CodelPolicy(int maxDepth, int target, int interval);
+        bool onDequeue(int sojourn, int queueSize, int currTime) override;
+        bool shedsOnDequeue() const override;
+        std::string getName() const override;
+};
+
+/**
+ * @class RedPolicy
+ * @brief Random early detection: sheds arrivals with a probability that grows with the queue depth.
+ *
+ * Below redMinFraction of the depth limit nothing is shed; from there the
+ * drop probability rises linearly to 1 at the limit. Uses the instantaneous
+ * depth rather than RED's averaged one, since the queue is sampled once per
+ * arrival in simulated time. Without a depth limit it admits everything.
+ */
+class RedPolicy : public ShedPolicy {
+    private:
+        int minDepth;                                 ///< Depth at which early shedding begins
+        std::mt19937 rng;                             ///< Engine for the drop decisions
+        std::uniform_real_distribution<> unit;        ///< Uniform [0, 1) draw
+
+    public:
+        RedPolicy(int maxDepth, double minFraction, unsigned int seed);
+        ShedAction onArrival(int queueSize) override;
+        std::string getName() const override;
+};
+
+#endif
@@ -0,0 +1,135 @@
+/**
+ * @file SpillStore.cpp
+ * @brief Implementation of the SpillStore class.
+ */
+
+#include "SpillStore.h"
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+void encodeRequest(const Request& request, char* record) {
+    uint32_t ipIn = request.getIpIn();
+    uint32_t ipOut = request.getIpOut();
+    int32_t processTime = request.getProcessTime();
+    int32_t arrivalTime = request.getArrivalTime();
+    std::memcpy(record, &ipIn, 4);
+    std::memcpy(record + 4, &ipOut, 4);
+    std::memcpy(record + 8, &processTime, 4);
+    std::memcpy(record + 12, &arrivalTime, 4);
+    record[16] = request.getJobType();
+    record[17] = record[18] = record[19] = 0;
+}
+
+Request decodeRequest(const char* record) {
+    uint32_t ipIn;
+    uint32_t ipOut;
+    int32_t processTime;
+    int32_t arrivalTime;
+    std::memcpy(&ipIn, record, 4);
+    std::memcpy(&ipOut, record + 4, 4);
+    std::memcpy(&processTime, record + 8, 4);
+    std::memcpy(&arrivalTime, record + 12, 4);
+    Request request(ipIn, ipOut, processTime, record[16]);
+    request.setArrivalTime(arrivalTime);
+    return request;
+}
+
+}
+
+SpillStore::SpillStore(const std::string& directory, int segmentRequests)
+    : directory(directory), segmentRequests(segmentRequests > 0 ? segmentRequests : 1), count(0), nextSegmentId(0) {
+}
+
+SpillStore::~SpillStore() {
+    for (Segment& segment : segments) {
+        releaseSegment(segment);
+    }
+}
+
+bool SpillStore::openSegment() {
+    Segment segment;
+    segment.path = directory + "/lb-spill-" + std::to_string(getpid()) + "-" +
+                   std::to_string(reinterpret_cast<uintptr_t>(this)) + "-" + std::to_string(nextSegmentId++) + ".seg";
+    segment.readIndex = 0;
+    segment.writeIndex = 0;
+
+    size_t bytes = segmentRequests * recordSize;
+    segment.fd = open(segment.path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (segment.fd < 0) {
+        return false;
+    }
+    if (ftruncate(segment.fd, bytes) != 0) {
+        close(segment.fd);
+        unlink(segment.path.c_str());
+        return false;
+    }
+    void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, segment.fd, 0);
+    if (mapping == MAP_FAILED) {
+        close(segment.fd);
+        unlink(segment.path.c_str());
+        return false;
+    }
+    segment.data = static_cast<char*>(mapping);
+    segments.push_back(segment);
+    return true;
+}
+
+void SpillStore::releaseSegment(Segment& segment) {
+    munmap(segment.data, segmentRequests * recordSize);
+    close(segment.fd);
+    unlink(segment.path.c_str());
+}
+
+bool SpillStore::append(const Request& request) {
+    if (segments.empty() || segments.back().writeIndex == segmentRequests) {
+        if (!openSegment()) {
+            return false;
+        }
+    }
+    Segment& segment = segments.back();
+    encodeRequest(request, segment.data + segment.writeIndex * recordSize);
+    segment.writeIndex++;
+    count++;
+
+    if (segment.writeIndex == segmentRequests) {
+        // the full segment will not be touched again until it reaches the front
+        madvise(segment.data, segmentRequests * recordSize, MADV_DONTNEED);
+    }
+    return true;
+}
+
+int SpillStore::read(Request* out, int maxCount) {
+    int done = 0;
+    while (done < maxCount && count > 0) {
+        Segment& segment = segments.front();
+        while (done < maxCount && segment.readIndex < segment.writeIndex) {
+            out[done++] = decodeRequest(segment.data + segment.readIndex * recordSize);
+            segment.readIndex++;
+            count--;
+        }
+        if (segment.readIndex < segment.writeIndex) {
+            break;
+        }
+        if (segments.size() > 1) {
+            releaseSegment(segment);
+            segments.pop_front();
+        } else {
+            segment.readIndex = 0;
+            segment.writeIndex = 0;
+        }
+    }
+    return done;
+}
+
+size_t SpillStore::size() const {
+    return count;
+}
+
+size_t SpillStore::segmentCount() const {
+    return segments.size();
+}
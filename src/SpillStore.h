@@ -0,0 +1,106 @@
+/**
+ * @file SpillStore.h
+ * @brief Declaration of the SpillStore class, an on-disk FIFO of requests in memory-mapped segment files.
+ */
+
+#ifndef SPILLSTORE_H
+#define SPILLSTORE_H
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include "Request.h"
+
+/**
+ * @class SpillStore
+ * @brief Append-only FIFO of requests kept in memory-mapped segment files.
+ *
+ * Each segment is a file of segmentRequests fixed-width records, mapped
+ * shared so writes go to the page cache and from there to disk. A segment
+ * that fills up is advised out of the process's memory, so the kernel can
+ * write it back and reclaim the pages while it waits to be read. Reads page
+ * it back in. Segments are unlinked once fully read, except that an empty
+ * store keeps its last segment and rewinds it for reuse.
+ *
+ * Record layout (20 bytes, host byte order): ipIn, ipOut, processTime and
+ * arrivalTime as 32-bit integers, then jobType and three bytes of padding.
+ */
+class SpillStore {
+    private:
+        /**
+         * @struct Segment
+         * @brief One mapped segment file and its read and write positions.
+         */
+        struct Segment {
+            std::string path;     ///< File path, removed when the segment is released
+            int fd;               ///< Open file descriptor
+            char* data;           ///< Start of the mapping
+            size_t readIndex;     ///< Next record to read
+            size_t writeIndex;    ///< Next record to write
+        };
+
+        std::string directory;           ///< Directory the segment files are created in
+        size_t segmentRequests;          ///< Records per segment file
+        std::deque<Segment> segments;    ///< Segments in FIFO order; reads from the front, writes to the back
+        size_t count;                    ///< Records written and not yet read
+        unsigned int nextSegmentId;      ///< Number used in the next segment file name
+
+        /**
+         * @brief Creates, sizes and maps a new segment file at the back.
+         * @return true on success, false if the file could not be created or mapped.
+         */
+        bool openSegment();
+
+        /**
+         * @brief Unmaps, closes and removes a segment file.
+         * @param segment Segment to release.
+         */
+        void releaseSegment(Segment& segment);
+
+    public:
+        static const size_t recordSize = 20;   ///< Bytes per serialized request
+
+        /**
+         * @brief Creates an empty store. No file is created until the first append.
+         * @param directory Directory for the segment files.
+         * @param segmentRequests Records per segment file (at least 1).
+         */
+        SpillStore(const std::string& directory, int segmentRequests);
+
+        /**
+         * @brief Releases every segment file.
+         */
+        ~SpillStore();
+
+        SpillStore(const SpillStore&) = delete;
+        SpillStore& operator=(const SpillStore&) = delete;
+
+        /**
+         * @brief Appends a request at the back of the store.
+         * @param request Request to store.
+         * @return true on success, false if a new segment file could not be created.
+         */
+        bool append(const Request& request);
+
+        /**
+         * @brief Removes up to maxCount requests from the front of the store, in order.
+         * @param out Array with room for maxCount requests.
+         * @param maxCount Largest number of requests to read.
+         * @return Number of requests written to out.
+         */
+        int read(Request* out, int maxCount);
+
+        /**
+         * @brief Returns the number of stored requests.
+         * @return Store size.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Returns the number of segment files currently open.
+         * @return Segment count.
+         */
+        size_t segmentCount() const;
+};
+
+#endif
@@ -0,0 +1,231 @@
+/**
+ * @file SweepRunner.cpp
+ * @brief Implementation of the SweepRunner class.
+ */
+
+#include "SweepRunner.h"
+#include "LoadBalancer.h"
+#include "LogFile.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+SweepRunner::SweepRunner(const Config& base)
+    : base(base), runs(1), threads(std::max(static_cast<int>(std::thread::hardware_concurrency()), 1)) {
+}
+
+bool SweepRunner::addSetting(const std::string& key, const std::string& value) {
+    Config probe = base;
+    try {
+        if (!probe.applySetting(key, value)) {
+            std::cerr << "Unknown sweep key: " << key << std::endl;
+            return false;
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Invalid value for " << key << ": " << value << std::endl;
+        return false;
+    }
+    if (std::find(columns.begin(), columns.end(), key) == columns.end()) {
+        columns.push_back(key);
+    }
+    return true;
+}
+
+bool SweepRunner::loadFromFile(const std::string& filename) {
+    std::ifstream file(filename);
+
+    if (!file.is_open()) {
+        std::cerr << "Failed to open sweep file: " << filename << std::endl;
+        return false;
+    }
+
+    std::string line;
+
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        size_t equal_pos = line.find('=');
+
+        if (equal_pos == std::string::npos) {
+            continue;
+        }
+
+        std::string key = line.substr(0, equal_pos);
+        std::string value = line.substr(equal_pos + 1);
+
+        if (key == "runs" || key == "threads") {
+            int count;
+            try {
+                count = std::stoi(value);
+            } catch (const std::exception&) {
+                std::cerr << "Invalid value for " << key << ": " << value << std::endl;
+                return false;
+            }
+            if (key == "runs") {
+                runs = std::max(count, 1);
+            } else if (count > 0) {
+                threads = count;
+            }
+        } else if (key == "variant") {
+            Settings settings;
+            std::istringstream iss(value);
+            std::string pair;
+            while (iss >> pair) {
+                size_t split = pair.find('=');
+                if (split == std::string::npos) {
+                    std::cerr << "Malformed variant setting: " << pair << std::endl;
+                    return false;
+                }
+                settings.push_back(std::make_pair(pair.substr(0, split), pair.substr(split + 1)));
+                if (!addSetting(settings.back().first, settings.back().second)) {
+                    return false;
+                }
+            }
+            listed.push_back(settings);
+        } else if (key == "blockedIpRanges") {
+            base.applySetting(key, value);
+        } else {
+            std::vector<std::string> candidates;
+            std::istringstream iss(value);
+            std::string candidate;
+            while (std::getline(iss, candidate, ',')) {
+                if (!addSetting(key, candidate)) {
+                    return false;
+                }
+                candidates.push_back(candidate);
+            }
+            axisKeys.push_back(key);
+            axisValues.push_back(candidates);
+        }
+    }
+    return true;
+}
+
+void SweepRunner::expandVariants() {
+    variants.assign(1, Settings());
+    for (size_t axis = 0; axis < axisKeys.size(); axis++) {
+        std::vector<Settings> expanded;
+        for (const Settings& partial : variants) {
+            for (const std::string& value : axisValues[axis]) {
+                expanded.push_back(partial);
+                expanded.back().push_back(std::make_pair(axisKeys[axis], value));
+            }
+        }
+        variants.swap(expanded);
+    }
+
+    if (!listed.empty()) {
+        std::vector<Settings> expanded;
+        for (const Settings& extra : listed) {
+            for (const Settings& grid : variants) {
+                expanded.push_back(grid);
+                expanded.back().insert(expanded.back().end(), extra.begin(), extra.end());
+            }
+        }
+        variants.swap(expanded);
+    }
+}
+
+SweepResult SweepRunner::runOne(const Settings& settings, unsigned int seed) const {
+    Config config = base;
+    for (const auto& setting : settings) {
+        config.applySetting(setting.first, setting.second);
+    }
+    config.applySetting("seed", std::to_string(seed));
+    // variants run concurrently, so none of them may write the shared metrics file
+    config.applySetting("metricsFile", "");
+
+    LogFile stats;
+    LoadBalancer loadBalancer(config, &stats);
+    loadBalancer.init();
+    loadBalancer.run();
+
+    const WaitStats& waits = loadBalancer.getWaitStats();
+    return SweepResult{loadBalancer.getCurrTime(), stats.getRequestsProcessed(), stats.getRequestsShed(),
+                       waits.getMean(), waits.getPercentile(0.99),
+                       loadBalancer.getServerCycles()};
+}
+
+void SweepRunner::run() {
+    expandVariants();
+
+    // a fixed base seed makes the whole sweep reproducible; 0 still gives every replica its own stream
+    seeds.resize(runs);
+    std::random_device rd;
+    for (int r = 0; r < runs; r++) {
+        if (base.getSeed() != 0) {
+            // step through the nonzero seeds only, so a base near UINT_MAX wraps to 1 rather than to 0 (random)
+            seeds[r] = (static_cast<uint64_t>(base.getSeed()) - 1 + r) % 0xFFFFFFFFULL + 1;
+        } else {
+            seeds[r] = std::max(rd(), 1u);
+        }
+    }
+
+    int jobs = variants.size() * runs;
+    results.assign(jobs, SweepResult());
+    std::atomic<int> nextJob(0);
+
+    std::vector<std::thread> workers;
+    int workerCount = std::min(threads, jobs);
+    for (int i = 0; i < workerCount; i++) {
+        workers.emplace_back([this, jobs, &nextJob]() {
+            int job;
+            while ((job = nextJob.fetch_add(1)) < jobs) {
+                results[job] = runOne(variants[job / runs], seeds[job % runs]);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void SweepRunner::printResults(std::ostream& out) const {
+    const int width = 14;
+
+    for (const std::string& column : columns) {
+        out << std::setw(std::max(width, static_cast<int>(column.size()) + 1)) << column;
+    }
+    out << std::setw(width) << "throughput" << std::setw(width) << "shed" << std::setw(width) << "meanWait"
+        << std::setw(width) << "p99Wait" << std::setw(width) << "serverCycles" << std::endl;
+
+    for (size_t v = 0; v < variants.size(); v++) {
+        double throughput = 0;
+        double shed = 0;
+        double meanWait = 0;
+        double p99Wait = 0;
+        double serverCycles = 0;
+        for (int r = 0; r < runs; r++) {
+            const SweepResult& result = results[v * runs + r];
+            throughput += static_cast<double>(result.processed) / std::max(result.cycles, 1);
+            shed += result.shed;
+            meanWait += result.meanWait;
+            p99Wait += result.p99Wait;
+            serverCycles += result.serverCycles;
+        }
+
+        for (const std::string& column : columns) {
+            // the last setting of a key wins, matching the order runOne() applies them in
+            std::string value = "-";
+            for (const auto& setting : variants[v]) {
+                if (setting.first == column) {
+                    value = setting.second;
+                }
+            }
+            out << std::setw(std::max(width, static_cast<int>(column.size()) + 1)) << value;
+        }
+        out << std::fixed << std::setprecision(4) << std::setw(width) << throughput / runs
+            << std::setprecision(0) << std::setw(width) << shed / runs
+            << std::setprecision(2) << std::setw(width) << meanWait / runs
+            << std::setw(width) << p99Wait / runs
+            << std::setprecision(0) << std::setw(width) << serverCycles / runs << std::endl;
+    }
+}
@@ -0,0 +1,108 @@
+/**
+ * @file SweepRunner.h
+ * @brief Declaration of the SweepRunner class for headless parameter sweeps.
+ */
+
+#ifndef SWEEPRUNNER_H
+#define SWEEPRUNNER_H
+
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Config.h"
+
+/**
+ * @struct SweepResult
+ * @brief Statistics collected from one headless simulation run.
+ */
+struct SweepResult {
+    int cycles;               ///< Clock cycles simulated
+    int processed;            ///< Requests completed during the run
+    int shed;                 ///< Requests shed by admission control
+    double meanWait;          ///< Mean queue wait in cycles
+    int p99Wait;              ///< 99th percentile queue wait in cycles
+    long long serverCycles;   ///< Servers times cycles used over the run
+};
+
+/**
+ * @class SweepRunner
+ * @brief Runs many independent LoadBalancer instances over a grid of Config variants.
+ *
+ * The sweep file uses the config.txt format on top of a base Config:
+ *  - a key with comma-separated values (e.g. maxQueuePerServer=60,80,100) is a
+ *    grid axis; every combination of axes is one variant;
+ *  - a variant= line lists space-separated key=value settings forming one
+ *    extra variant (e.g. variant=autoscaler=predictive maxScaleStep=8); when
+ *    present, the grid is run once for each of them;
+ *  - runs= sets the number of seeded replicas per variant and threads= the
+ *    size of the thread pool (0 or absent: one per hardware thread).
+ *
+ * blockedIpRanges contains commas itself and cannot be swept. Replica r uses
+ * the same seed in every variant, so variants are compared on identical
+ * request streams. Each run logs to a stats-only LogFile, so nothing is
+ * written to disk or the console until printResults().
+ */
+class SweepRunner {
+    private:
+        typedef std::vector<std::pair<std::string, std::string>> Settings;
+
+        Config base;                        ///< Configuration every variant starts from
+        std::vector<std::string> axisKeys;  ///< Swept keys, in file order
+        std::vector<std::vector<std::string>> axisValues; ///< Candidate values of each swept key
+        std::vector<Settings> listed;       ///< Variants given on variant= lines
+        std::vector<std::string> columns;   ///< Keys shown in the results table
+        int runs;                           ///< Replicas per variant
+        int threads;                        ///< Worker threads in the pool
+
+        std::vector<Settings> variants;     ///< Settings of each variant, filled by run()
+        std::vector<unsigned int> seeds;    ///< Seed of each replica
+        std::vector<SweepResult> results;   ///< One result per variant and replica, variant-major
+
+        /**
+         * @brief Checks that a setting is known and parses, then adds its key to the table columns.
+         * @return true if the setting is valid.
+         */
+        bool addSetting(const std::string& key, const std::string& value);
+
+        /**
+         * @brief Builds the variant list from the grid axes and the variant= lines.
+         */
+        void expandVariants();
+
+        /**
+         * @brief Runs one simulation of a variant with a replica's seed.
+         */
+        SweepResult runOne(const Settings& settings, unsigned int seed) const;
+
+    public:
+        /**
+         * @brief Constructs a sweep over the given base configuration.
+         * @param base Configuration that every variant starts from.
+         */
+        explicit SweepRunner(const Config& base);
+
+        /**
+         * @brief Loads the grid, variants, replica count and thread count from a sweep file.
+         * @param filename Path to the sweep file.
+         * @return true if the file was opened and every setting is valid, false otherwise.
+         */
+        bool loadFromFile(const std::string& filename);
+
+        /**
+         * @brief Runs every variant and replica on the thread pool.
+         */
+        void run();
+
+        /**
+         * @brief Writes one row per variant with statistics averaged over its replicas.
+         *
+         * Columns: the swept keys, throughput (requests completed per cycle),
+         * requests shed, mean and p99 queue wait, and server-cycles used.
+         *
+         * @param out Stream to write the table to.
+         */
+        void printResults(std::ostream& out) const;
+};
+
+#endif
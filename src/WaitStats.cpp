@@ -0,0 +1,85 @@
+/**
+ * @file WaitStats.cpp
+ * @brief Implementation of the WaitStats class.
+ */
+
+#include "WaitStats.h"
+#include <algorithm>
+#include <cmath>
+
+WaitStats::WaitStats() : count(0), sum(0), maxWait(0) {
+}
+
+int WaitStats::bucketIndex(int wait) {
+    if (wait < 2 * subBucketCount) {
+        return wait;
+    }
+    // shift so the value keeps subBucketBits + 1 significant bits; its top bit selects the upper half of a range
+    int shift = (31 - __builtin_clz(static_cast<unsigned>(wait))) - subBucketBits;
+    return shift * subBucketCount + (wait >> shift);
+}
+
+int WaitStats::bucketHighest(int index) {
+    if (index < 2 * subBucketCount) {
+        return index;
+    }
+    int shift = index / subBucketCount - 1;
+    long long highest = (static_cast<long long>(index - shift * subBucketCount + 1) << shift) - 1;
+    return static_cast<int>(std::min<long long>(highest, 0x7fffffff));
+}
+
+void WaitStats::record(int wait) {
+    if (wait < 0) {
+        wait = 0;
+    }
+    int index = bucketIndex(wait);
+    if (index >= static_cast<int>(buckets.size())) {
+        buckets.resize(index + 1, 0);
+    }
+    buckets[index]++;
+    count++;
+    sum += wait;
+    if (wait > maxWait) {
+        maxWait = wait;
+    }
+}
+
+void WaitStats::clear() {
+    std::fill(buckets.begin(), buckets.end(), 0);
+    count = 0;
+    sum = 0;
+    maxWait = 0;
+}
+
+long long WaitStats::getCount() const {
+    return count;
+}
+
+double WaitStats::getMean() const {
+    if (count == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(sum) / count;
+}
+
+int WaitStats::getPercentile(double fraction) const {
+    if (count == 0) {
+        return 0;
+    }
+    long long rank = static_cast<long long>(std::ceil(fraction * count));
+    if (rank < 1) {
+        rank = 1;
+    }
+    long long seen = 0;
+    for (size_t index = 0; index < buckets.size(); index++) {
+        seen += buckets[index];
+        if (seen >= rank) {
+            return std::min(bucketHighest(index), maxWait);
+        }
+    }
+    return maxWait;
+}
+
+int WaitStats::getMax() const {
+    return maxWait;
+}
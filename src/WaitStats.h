@@ -0,0 +1,81 @@
+/**
+ * @file WaitStats.h
+ * @brief Declaration of the WaitStats class for summarizing request queue wait times.
+ */
+
+#ifndef WAITSTATS_H
+#define WAITSTATS_H
+
+#include <vector>
+
+/**
+ * @class WaitStats
+ * @brief Log-linear (HDR-style) histogram of times in clock cycles.
+ *
+ * Times below 2 * subBucketCount are counted exactly, one bucket per cycle.
+ * Above that each power-of-two range is split into subBucketCount equal
+ * buckets, so a reported percentile is never more than 1/subBucketCount
+ * (under 0.8%) above the true value. Recording is O(1): the bucket index is
+ * a shift of the time by its highest set bit. Buckets are allocated up to
+ * the largest time seen, at most about 3200 of them for any int, so the
+ * memory is fixed no matter how many times are recorded.
+ */
+class WaitStats {
+    private:
+        static const int subBucketBits = 7;                     ///< log2 of the buckets per power of two
+        static const int subBucketCount = 1 << subBucketBits;   ///< Buckets per power of two above the exact range
+
+        std::vector<long long> buckets;  ///< Count of times falling in each bucket
+        long long count;                 ///< Total number of recorded times
+        long long sum;                   ///< Sum of all recorded times
+        int maxWait;                     ///< Largest recorded time
+
+        /**
+         * @brief Returns the bucket a time falls in.
+         * @param wait Non-negative time in cycles.
+         * @return Bucket index.
+         */
+        static int bucketIndex(int wait);
+
+        /**
+         * @brief Returns the largest time that falls in a bucket.
+         * @param index Bucket index.
+         * @return Largest time in cycles mapped to the bucket.
+         */
+        static int bucketHighest(int index);
+
+    public:
+        /** @brief Constructs an empty distribution. */
+        WaitStats();
+
+        /**
+         * @brief Records one time.
+         * @param wait Cycles measured for one request; negative values count as 0.
+         */
+        void record(int wait);
+
+        /** @brief Forgets every recorded time, keeping the allocated buckets. */
+        void clear();
+
+        /** @brief Returns the number of recorded times. */
+        long long getCount() const;
+
+        /** @brief Returns the mean time in cycles (0 if nothing was recorded). */
+        double getMean() const;
+
+        /**
+         * @brief Returns the smallest time at or below which the given fraction of times fall.
+         *
+         * Above the exact range the result is the top of the bucket the
+         * percentile lands in, capped at the maximum.
+         *
+         * @param fraction Fraction in [0, 1], e.g. 0.99 for the 99th percentile.
+         * @return Percentile time in cycles.
+         */
+        int getPercentile(double fraction) const;
+
+        /** @brief Returns the largest recorded time in cycles. */
+        int getMax() const;
+};
+
+#endif
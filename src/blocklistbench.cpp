@@ -0,0 +1,146 @@
+/**
+ * @file blocklistbench.cpp
+ * @brief Entry point for blocklistbench, which times the compiled Blocklist against a linear scan of the ranges.
+ *
+ * Usage:
+ * @code{.sh}
+ * make bench
+ * ./blocklistbench
+ * @endcode
+ *
+ * For 10, 10k and 1M random ranges, drawn from a fixed seed so that about
+ * a quarter of the address space is blocked and many ranges overlap, it
+ * reports the time to compile the Blocklist and the time per lookup of
+ * random addresses, next to the loop over IpRange::contains() that
+ * isIpBlocked() used before. Every address the linear scan looks up is
+ * also looked up in the Blocklist, as are the addresses on and either side
+ * of some range bounds, and the program fails if any answer differs.
+ */
+
+#include "Blocklist.h"
+#include "IpRange.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/// Addresses looked up in the Blocklist per row
+static const int blocklistLookups = 1000000;
+
+/// Range tests the linear scan may spend per row, so the 1M-range row stays short
+static const long long linearBudget = 100000000;
+
+/**
+ * @brief Returns the nanoseconds elapsed since start.
+ * @param start Time point to measure from.
+ */
+double nsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Checks an address against every range in turn, as isIpBlocked() did before the Blocklist.
+ * @param ranges Blocked ranges.
+ * @param ip Address to check.
+ * @return true if any range contains ip.
+ */
+bool linearContains(const vector<IpRange>& ranges, uint32_t ip) {
+    for (const IpRange& range : ranges) {
+        if (range.contains(ip)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Formats a duration in the largest unit that keeps it above 1.
+ * @param ns Duration in nanoseconds.
+ * @return Duration with its unit, e.g. "45 ns" or "1.1 ms".
+ */
+string formatTime(double ns) {
+    ostringstream out;
+    out << fixed;
+    if (ns >= 1e6) {
+        out << setprecision(1) << ns / 1e6 << " ms";
+    } else if (ns >= 1e3) {
+        out << setprecision(1) << ns / 1e3 << " us";
+    } else {
+        out << setprecision(0) << ns << " ns";
+    }
+    return out.str();
+}
+
+int main() {
+    mt19937 gen(42);
+    bool ok = true;
+
+    cout << "BLOCKLIST (random ranges covering about a quarter of the address space; "
+         << blocklistLookups << " lookups per row):" << endl;
+    cout << "  Ranges     Intervals       Build    Blocklist   Linear scan" << endl;
+    for (int count : {10, 10000, 1000000}) {
+        // mean width 2^32 / (4 * count), so the ranges overlap often but leave most addresses open
+        uint32_t maxWidth = static_cast<uint32_t>((1ull << 32) / (2ull * count));
+        uniform_int_distribution<uint32_t> width(0, maxWidth);
+        vector<IpRange> ranges;
+        ranges.reserve(count);
+        for (int i = 0; i < count; i++) {
+            uint32_t start = gen();
+            uint32_t end = start + min(width(gen), 0xFFFFFFFFu - start);
+            ranges.push_back(IpRange(IpRange::toString(start), IpRange::toString(end)));
+        }
+
+        auto start = chrono::steady_clock::now();
+        Blocklist blocklist(ranges);
+        double build = nsSince(start);
+
+        vector<uint32_t> addresses(blocklistLookups);
+        for (uint32_t& ip : addresses) {
+            ip = gen();
+        }
+        long long hits = 0;
+        start = chrono::steady_clock::now();
+        for (uint32_t ip : addresses) {
+            hits += blocklist.contains(ip);
+        }
+        double compiled = nsSince(start) / addresses.size();
+
+        int linearLookups = static_cast<int>(min<long long>(blocklistLookups, max<long long>(linearBudget / count, 100)));
+        long long linearHits = 0;
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < linearLookups; i++) {
+            linearHits += linearContains(ranges, addresses[i]);
+        }
+        double linear = nsSince(start) / linearLookups;
+
+        vector<uint32_t> checked(addresses.begin(), addresses.begin() + linearLookups);
+        for (int i = 0; i < min(count, linearLookups / 4); i++) {
+            uint32_t first = ranges[i].getStartAddress();
+            uint32_t last = ranges[i].getEndAddress();
+            checked.insert(checked.end(), {first - 1, first, last, last + 1});
+        }
+        for (uint32_t ip : checked) {
+            if (blocklist.contains(ip) != linearContains(ranges, ip)) {
+                ok = false;
+            }
+        }
+        // keeps the timed lookups from being optimized away
+        if (hits < linearHits) {
+            ok = false;
+        }
+
+        cout << "  " << left << setw(9) << count << right << setw(11) << blocklist.intervalCount()
+             << setw(12) << formatTime(build) << setw(13) << formatTime(compiled)
+             << setw(14) << formatTime(linear) << endl;
+    }
+    if (!ok) {
+        cout << "MISMATCH: the Blocklist and the linear scan disagree" << endl;
+    }
+    return ok ? 0 : 1;
+}
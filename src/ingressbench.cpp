@@ -0,0 +1,292 @@
+/**
+ * @file ingressbench.cpp
+ * @brief Entry point for ingressbench, the stress test and throughput benchmark of the ingress queue.
+ *
+ * Usage:
+ * @code{.sh}
+ * make bench
+ * ./ingressbench [requestsPerProducer]
+ * @endcode
+ *
+ * The stress test runs 1, 2, 4, 8 and 16 producers against 1 and 4
+ * consumers of one ConcurrentRequestQueue. Every request carries its
+ * producer and sequence number, and the run fails unless each one is
+ * received exactly once, each consumer sees every producer's requests in
+ * order, and sizeApprox() stays within [0, capacity()].
+ *
+ * The benchmark then reports requests per second for 1 to 16 producers,
+ * first straight into the queue with one consumer, then through
+ * LoadBalancer::submit() while a tick-mode simulation drains the queue
+ * every cycle. Every address is blocked in that simulation, so each
+ * drained request takes the full admission path and is counted, and the
+ * count is checked against the requests submit() accepted.
+ *
+ * Exits with status 1 if any check fails; the benchmark only runs once the
+ * stress test has passed.
+ */
+
+#include "ConcurrentRequestQueue.h"
+#include "Config.h"
+#include "LoadBalancer.h"
+#include "LogFile.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/// Capacity of the queue under test, the default ingressQueueSize
+static const int queueCapacity = 4096;
+
+/// Length of each simulation behind the submit() benchmark; long enough that thread start-up is noise
+static const int submitCycles = 2000000;
+
+/// Producer counts the stress test and the benchmark step through
+static const int producerCounts[] = {1, 2, 4, 8, 16};
+
+/**
+ * @brief Returns the seconds elapsed since start.
+ * @param start Time point to measure from.
+ */
+double secondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Pushes count requests tagged with the producer id and their sequence number.
+ * @param queue Queue to push into.
+ * @param producer Producer id, stored as the source address.
+ * @param count Number of requests to push.
+ */
+void produce(ConcurrentRequestQueue& queue, int producer, int count) {
+    for (int seq = 0; seq < count; seq++) {
+        Request request(producer, seq, 1, 'P');
+        while (!queue.tryPush(request)) {
+            this_thread::yield();
+        }
+    }
+}
+
+/**
+ * @brief Runs one stress configuration and checks what the consumers received.
+ * @param producers Number of producer threads.
+ * @param consumers Number of consumer threads.
+ * @param perProducer Requests pushed by each producer.
+ * @return true if every check passed.
+ */
+bool stress(int producers, int consumers, int perProducer) {
+    ConcurrentRequestQueue queue(queueCapacity);
+    long long total = static_cast<long long>(producers) * perProducer;
+    atomic<long long> received(0);
+    atomic<bool> failed(false);
+    atomic<bool> done(false);
+    atomic<int> producersLeft(producers);
+
+    // each consumer marks what it saw; the marks are merged once every thread has joined
+    vector<vector<vector<bool>>> seen(consumers, vector<vector<bool>>(producers, vector<bool>(perProducer, false)));
+    vector<thread> threads;
+    for (int c = 0; c < consumers; c++) {
+        threads.emplace_back([&, c]() {
+            vector<long long> last(producers, -1);
+            Request request;
+            while (received.load(memory_order_relaxed) < total) {
+                if (!queue.tryPop(request)) {
+                    // once the producers are gone an empty queue means whatever is missing was lost
+                    bool finished = producersLeft.load(memory_order_acquire) == 0;
+                    if (!finished || !queue.tryPop(request)) {
+                        if (finished) {
+                            break;
+                        }
+                        this_thread::yield();
+                        continue;
+                    }
+                }
+                received.fetch_add(1, memory_order_relaxed);
+                uint32_t producer = request.getIpIn();
+                uint32_t seq = request.getIpOut();
+                if (producer >= static_cast<uint32_t>(producers) || seq >= static_cast<uint32_t>(perProducer) ||
+                    static_cast<long long>(seq) <= last[producer]) {
+                    failed = true;
+                    continue;
+                }
+                last[producer] = seq;
+                seen[c][producer][seq] = true;
+            }
+        });
+    }
+    thread monitor([&]() {
+        while (!done.load(memory_order_relaxed)) {
+            int size = queue.sizeApprox();
+            if (size < 0 || size > queue.capacity()) {
+                failed = true;
+            }
+            this_thread::yield();
+        }
+    });
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p]() {
+            produce(queue, p, perProducer);
+            producersLeft.fetch_sub(1, memory_order_release);
+        });
+    }
+    for (thread& t : threads) {
+        t.join();
+    }
+    done = true;
+    monitor.join();
+
+    Request leftover;
+    if (received != total || queue.tryPop(leftover) || queue.sizeApprox() != 0) {
+        failed = true;
+    }
+    for (int p = 0; p < producers && !failed; p++) {
+        for (int seq = 0; seq < perProducer; seq++) {
+            int copies = 0;
+            for (int c = 0; c < consumers; c++) {
+                copies += seen[c][p][seq];
+            }
+            if (copies != 1) {
+                failed = true;
+                break;
+            }
+        }
+    }
+    return !failed;
+}
+
+/**
+ * @brief Times producers pushing perProducer requests each to one consumer.
+ * @param producers Number of producer threads.
+ * @param perProducer Requests pushed by each producer.
+ * @return Requests per second.
+ */
+double queueThroughput(int producers, int perProducer) {
+    ConcurrentRequestQueue queue(queueCapacity);
+    long long total = static_cast<long long>(producers) * perProducer;
+    auto start = chrono::steady_clock::now();
+    thread consumer([&]() {
+        Request request;
+        for (long long n = 0; n < total; ) {
+            if (queue.tryPop(request)) {
+                n++;
+            } else {
+                this_thread::yield();
+            }
+        }
+    });
+    vector<thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back(produce, ref(queue), p, perProducer);
+    }
+    for (thread& t : threads) {
+        t.join();
+    }
+    consumer.join();
+    return total / secondsSince(start);
+}
+
+/**
+ * @brief Times producers calling LoadBalancer::submit() while a simulation runs.
+ *
+ * Producers submit until the simulation finishes. Every address is
+ * blocked, so the simulation's blocked count must equal the requests
+ * submit() accepted minus those still waiting in the ingress queue.
+ *
+ * @param producers Number of producer threads.
+ * @param cycles Length of the simulation in cycles.
+ * @param ok Set to false if the counts disagree.
+ * @return Accepted requests per second.
+ */
+double submitThroughput(int producers, int cycles, bool& ok) {
+    Config config;
+    config.applySetting("seed", "42");
+    config.applySetting("initServers", "4");
+    config.applySetting("newRequestProb", "0");
+    config.applySetting("topTalkers", "0");
+    config.applySetting("blockedIpRanges", "0.0.0.0-255.255.255.255");
+    config.applySetting("ingressQueueSize", to_string(queueCapacity));
+    config.setTotalRunTime(cycles);
+
+    LogFile stats;
+    LoadBalancer loadBalancer(config, &stats);
+    loadBalancer.init();
+    int prefillBlocked = stats.getRequestsBlocked();
+
+    atomic<bool> running(true);
+    vector<long long> accepted(producers, 0);
+    vector<thread> threads;
+    auto start = chrono::steady_clock::now();
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p]() {
+            Request request(p, 0, 1, 'P');
+            while (running.load(memory_order_relaxed)) {
+                if (loadBalancer.submit(request)) {
+                    accepted[p]++;
+                } else {
+                    this_thread::yield();
+                }
+            }
+        });
+    }
+    loadBalancer.run();
+    running = false;
+    double elapsed = secondsSince(start);
+    for (thread& t : threads) {
+        t.join();
+    }
+
+    long long acceptedTotal = 0;
+    for (long long count : accepted) {
+        acceptedTotal += count;
+    }
+    long long drained = stats.getRequestsBlocked() - prefillBlocked;
+    if (drained + loadBalancer.getQueueSize() != acceptedTotal) {
+        cerr << "submit: " << acceptedTotal << " accepted but " << drained << " drained and "
+             << loadBalancer.getQueueSize() << " left queued" << endl;
+        ok = false;
+    }
+    return drained / elapsed;
+}
+
+int main(int argc, char* argv[]) {
+    int perProducer = argc > 1 ? atoi(argv[1]) : 200000;
+    if (perProducer <= 0) {
+        cerr << "Usage: " << argv[0] << " [requestsPerProducer]" << endl;
+        return 2;
+    }
+    bool ok = true;
+    cout << "Hardware threads: " << thread::hardware_concurrency() << endl << endl;
+
+    cout << "STRESS (" << perProducer << " requests per producer, capacity " << queueCapacity << "):" << endl;
+    for (int consumers : {1, 4}) {
+        for (int producers : producerCounts) {
+            bool passed = stress(producers, consumers, perProducer);
+            ok = ok && passed;
+            cout << "  " << setw(2) << producers << " producers, " << consumers << " consumer"
+                 << (consumers > 1 ? "s" : " ") << "  " << (passed ? "ok" : "FAILED") << endl;
+        }
+    }
+    cout << endl;
+    if (!ok) {
+        // the throughput runs wait for every request, so a queue that loses them would never finish
+        return 1;
+    }
+
+    // a fixed total keeps every row doing the same amount of work
+    int total = 16 * perProducer;
+    cout << "THROUGHPUT (Mreq/s; queue: " << total << " requests to 1 consumer, submit: " << submitCycles << "-cycle tick run):" << endl;
+    cout << "  Producers       Queue      Submit" << endl;
+    cout << fixed << setprecision(2);
+    for (int producers : producerCounts) {
+        double queueRate = queueThroughput(producers, total / producers);
+        double submitRate = submitThroughput(producers, submitCycles, ok);
+        cout << "  " << left << setw(9) << producers << right << setw(12) << queueRate / 1e6
+             << setw(12) << submitRate / 1e6 << endl;
+    }
+    return ok ? 0 : 1;
+}
@@ -22,12 +22,36 @@
  * | Class | Description |
  * |-------|-------------|
  * | LoadBalancer | Main orchestrator that manages servers and queue |
- * | WebServer | Processes one request at a time |
+ * | ServerPool | Struct-of-arrays pool of servers, each processing one request at a time with an optional local queue |
+ * | IndexedHeap | Slot-indexed min-heap used by the server pool for completions and load |
+ * | DispatchPolicy | Strategy that picks the server for each queued request |
+ * | Autoscaler | Strategy that decides how many servers to add or remove (threshold or predictive) |
+ * | ShedPolicy | Admission control that bounds the request queue and sheds load (drop-tail, drop-oldest, codel, red) |
+ * | SweepRunner | Runs a grid of Config variants headless on a thread pool and tabulates the results |
+ * | WaitStats | Log-linear histogram of request times used for wait and latency percentiles |
+ * | RequestTimings | Wait and end-to-end latency histograms per job type and server |
  * | Request | Data structure for web requests (IP in, IP out, time, type) |
- * | RequestQueue | FIFO queue for pending requests |
+ * | ArrivalProcess | Arrival models (bernoulli, poisson, mmpp, diurnal) giving the number of requests per cycle |
+ * | RequestGenerator | Seeded per-instance engines (xoshiro256, pcg32, mt19937) that generate requests in batches |
+ * | RequestQueue | FIFO queue for pending requests, with an optional spill-to-disk tier |
+ * | SpillStore | Append-only memory-mapped segment files holding the spilled part of the request queue |
+ * | ConcurrentRequestQueue | Bounded lock-free MPMC queue through which other threads submit requests |
+ * | EventQueue | Priority queue of scheduled events for the event-driven mode |
+ * | Shard | Partition of the server pool with a local queue, run on its own thread in parallel mode |
+ * | Barrier | Reusable barrier that synchronizes shard worker threads |
  * | Config | Loads and stores configuration settings |
  * | LogFile | Handles logging and summary generation |
+ * | BinaryLog | Block-framed varint encoding of log records for logFormat=binary, decoded by logdecode |
+ * | Dashboard | Live console screen redrawn at a capped rate in place of per-event lines |
+ * | LogRing | Lock-free single-producer ring carrying log records to the async writer thread |
+ * | MetricsRecorder | Per-cycle time series in page-aligned binary columns or CSV (metricsFile) |
  * | IpRange | Defines blocked IP address ranges |
+ * | Blocklist | Blocked ranges merged into sorted intervals with a branchless Eytzinger search |
+ * | BlocklistWatcher | Rebuilds the blocklist in the background on file edits and swaps it in atomically |
+ * | RateLimiter | Per-source-IP token buckets in a fixed-size hash table with CLOCK eviction |
+ * | HeavyHitters | Count-Min sketch and Space-Saving top-K of request sources in fixed memory |
+ * | OpenAddressTable | Linear-probing table keyed by IPv4 address, shared by RateLimiter and HeavyHitters |
+ * | CidrTrie | Poptrie-style IPv4/IPv6 prefix trie for blocklists loaded from a file |
  * 
  * @section workflow_sec How It Works
  * 
@@ -35,10 +59,16 @@
  * 2. Get user input for server count and run time
  * 3. Initialize servers and generate initial request queue
  * 4. Run simulation loop:
- *    - Maybe add new random request
+ *    - Add the cycle's arriving requests (count drawn from the arrival model)
  *    - Process servers (decrement time remaining)
  *    - Distribute queued requests to idle servers
  *    - Check scaling conditions (add/remove servers)
+ *    - In event mode (simulationMode=event), the same steps run only on
+ *      cycles where an arrival, completion, dispatch, scaling or status
+ *      event is scheduled
+ *    - In parallel mode (simulationMode=parallel), shards run these steps
+ *      on worker threads and meet every shardEpoch cycles to rebalance
+ *      queued work, log, and scale
  * 5. Write summary to log file
  * 
  * 
@@ -47,7 +77,39 @@
  * @code{.sh}
  * make
  * ./loadbalancer
+ * ./loadbalancer --sweep sweep.txt
+ * ./logdecode log.bin > log.txt
+ * ./logdecode --csv log.bin > events.csv
+ * make bench
+ * ./ingressbench
+ * ./poolbench
+ * ./requestbench
+ * ./queuebench
+ * ./blocklistbench
  * @endcode
+ *
+ * The --sweep form runs headless: it loads config.txt as the base, runs
+ * every variant in the sweep file (see SweepRunner) on a thread pool and
+ * prints one results table instead of prompting and writing log.txt.
+ *
+ * With logFormat=binary the run writes log.bin instead of log.txt;
+ * logdecode turns it back into the same text, or into CSV.
+ *
+ * Setting metricsFile also writes one row every metricsInterval cycles
+ * of queue depth, server counts, arrivals, completions, rejections and
+ * scaling actions, for plotting (see MetricsRecorder for the layout).
+ *
+ * make bench builds the benchmark drivers, which the default build skips:
+ *  - ingressbench stress-tests the lock-free ingress queue and times 1 to
+ *    16 producers, both on the queue alone and through LoadBalancer::submit();
+ *  - poolbench times the ServerPool tick loop against the old layout of
+ *    separately allocated servers at 10, 1k and 100k servers;
+ *  - requestbench times LoadBalancer::addRequest() against the old path of
+ *    string addresses re-parsed on every blocked-range check;
+ *  - queuebench times the ring-buffer RequestQueue against the old
+ *    std::queue wrapper, one request at a time and in batches;
+ *  - blocklistbench times building and searching a Blocklist against a
+ *    linear scan of the ranges at 10, 10k and 1M ranges.
  * 
  * @section author_sec Author
  * 
@@ -59,6 +121,7 @@
 #include "LoadBalancer.h"
 #include "Config.h"
 #include "LogFile.h"
+#include "SweepRunner.h"
 #include <iostream>
 #include <string>
 
@@ -89,21 +152,45 @@ int getValidInt(const string& prompt, int minVal, int maxVal) {
     }
 }
 
+/**
+ * @brief Runs a headless parameter sweep and prints its results table.
+ * @param config Base configuration loaded from config.txt.
+ * @param sweepFile Path to the sweep file.
+ * @return 0 on success, 1 if the sweep file could not be loaded.
+ */
+int runSweep(const Config& config, const string& sweepFile) {
+    SweepRunner sweep(config);
+    if (!sweep.loadFromFile(sweepFile)) {
+        return 1;
+    }
+    sweep.run();
+    sweep.printResults(cout);
+    return 0;
+}
+
 /**
  * @brief Application entry point.
  *
  * Loads simulation settings from config.txt (falls back to defaults on failure),
  * accepts user overrides for server count and run time, then runs the full
- * LoadBalancer simulation and writes results to log.txt.
+ * LoadBalancer simulation and writes results to log.txt. With --sweep FILE it
+ * runs a headless parameter sweep instead.
  *
+ * @param argc Argument count.
+ * @param argv Arguments; "--sweep FILE" selects sweep mode.
  * @return 0 on successful completion.
  */
-int main(){
-    printf("=== Load Balancer Simulation ===\n");
-
+int main(int argc, char* argv[]){
     Config config;
     string configFile = "config.txt";
 
+    if (argc == 3 && string(argv[1]) == "--sweep") {
+        config.loadFromFile(configFile);
+        return runSweep(config, argv[2]);
+    }
+
+    printf("=== Load Balancer Simulation ===\n");
+
     cout << "Loading config from file: " << configFile << endl;
 
     if (config.loadFromFile(configFile)) {
@@ -123,7 +210,34 @@ int main(){
     cout << endl;
     config.printConfig();
 
-    LogFile logFile("log.txt", true);
+    bool binaryLog = config.getLogFormat() == "binary";
+    if (!binaryLog && config.getLogFormat() != "text") {
+        cerr << "Unknown log format '" << config.getLogFormat() << "', using text" << endl;
+    }
+    string logName = binaryLog ? "log.bin" : "log.txt";
+    const string& consoleMode = config.getConsoleMode();
+    if (consoleMode != "events" && consoleMode != "dashboard" && consoleMode != "off") {
+        cerr << "Unknown console mode '" << consoleMode << "', using events" << endl;
+    }
+    LogFile logFile(logName, consoleMode != "dashboard" && consoleMode != "off", binaryLog);
+    if (consoleMode == "dashboard") {
+        logFile.startDashboard(config.getDashboardRefreshRate(), config.getTotalRunTime());
+    }
+    unsigned categories;
+    if (!LogFile::parseCategories(config.getLogCategories(), categories)) {
+        cerr << "Unknown log category in '" << config.getLogCategories() << "', using all" << endl;
+        LogFile::parseCategories("all", categories);
+    }
+    logFile.setCategories(categories);
+    logFile.setSampleRate(config.getLogSampleRate());
+    if (config.getLogMode() == "async") {
+        if (config.getLogOverflow() != "block" && config.getLogOverflow() != "drop") {
+            cerr << "Unknown log overflow policy '" << config.getLogOverflow() << "', using block" << endl;
+        }
+        logFile.startAsync(config.getLogBufferSize(), config.getLogOverflow() == "drop");
+    } else if (config.getLogMode() != "sync") {
+        cerr << "Unknown log mode '" << config.getLogMode() << "', using sync" << endl;
+    }
 
     LoadBalancer loadBalancer(config, &logFile);
 
@@ -135,7 +249,7 @@ int main(){
 
     logFile.close();
 
-    cout << endl << "Simulation complete. Log written to log.txt" << endl;
+    cout << endl << "Simulation complete. Log written to " << logName << endl;
 
     return 0;
 
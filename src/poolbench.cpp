@@ -0,0 +1,220 @@
+/**
+ * @file poolbench.cpp
+ * @brief Entry point for poolbench, which times the struct-of-arrays ServerPool against the old server layout.
+ *
+ * Usage:
+ * @code{.sh}
+ * make bench
+ * ./poolbench
+ * @endcode
+ *
+ * Both sides run the per-cycle server work of tick mode with every server
+ * kept busy: advance every server by one cycle, retire the requests that
+ * finished, and start a new request on each server that went idle. The
+ * old layout is reproduced here as it was before ServerPool: a vector of
+ * separately allocated servers, each holding a request with two string
+ * addresses, advanced one server at a time and refilled by a second scan
+ * for idle servers.
+ *
+ * Process times are drawn from a fixed seed in [5, 20], the default
+ * config.txt bounds, and both sides get the same request sequence.
+ */
+
+#include "IpRange.h"
+#include "Request.h"
+#include "ServerPool.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/// Server-cycles simulated per row, so every pool size does the same work
+static const long long serverCyclesPerRow = 50000000;
+
+/// Requests generated up front and cycled through
+static const int requestCount = 1 << 16;
+
+/**
+ * @struct LegacyRequest
+ * @brief The request as it was stored before addresses became uint32_t.
+ */
+struct LegacyRequest {
+    string ipIn;       ///< Source IP address in dotted form
+    string ipOut;      ///< Destination IP address in dotted form
+    int processTime;   ///< Clock cycles the request takes
+    char jobType;      ///< 'P' or 'S'
+};
+
+/**
+ * @class LegacyServer
+ * @brief The web server as it was before ServerPool: one heap object per server.
+ */
+class LegacyServer {
+    private:
+        int serverId;                ///< Server ID
+        bool busy;                   ///< True while a request is being processed
+        LegacyRequest currRequest;   ///< Request being processed
+        int timeRemaining;           ///< Cycles left on currRequest
+
+    public:
+        /** @brief Creates an idle server. */
+        explicit LegacyServer(int id) : serverId(id), busy(false), timeRemaining(0) {
+        }
+
+        /** @brief Returns true while a request is being processed. */
+        bool isBusy() const {
+            return busy;
+        }
+
+        /** @brief Returns a copy of the current request, as the old accessor did. */
+        LegacyRequest getCurrentRequest() const {
+            return currRequest;
+        }
+
+        /** @brief Starts a request. */
+        void assignRequest(const LegacyRequest& request) {
+            currRequest = request;
+            timeRemaining = request.processTime;
+            busy = true;
+        }
+
+        /** @brief Advances one cycle and returns true if the request just finished. */
+        bool advanceClockCycle() {
+            if (!busy) {
+                return false;
+            }
+            timeRemaining--;
+            if (timeRemaining <= 0) {
+                busy = false;
+                return true;
+            }
+            return false;
+        }
+
+        /** @brief Marks the server idle. */
+        void setIdle() {
+            busy = false;
+            timeRemaining = 0;
+        }
+};
+
+/**
+ * @brief Runs the old per-cycle loop over heap-allocated servers.
+ * @param serverCount Number of servers.
+ * @param cycles Number of cycles to run.
+ * @param requests Requests to start, cycled through in order.
+ * @param completed Set to the number of requests that finished.
+ * @return Nanoseconds per server per cycle.
+ */
+double runLegacy(int serverCount, long long cycles, const vector<LegacyRequest>& requests, long long& completed) {
+    vector<LegacyServer*> servers;
+    for (int i = 0; i < serverCount; i++) {
+        servers.push_back(new LegacyServer(i + 1));
+    }
+    size_t next = 0;
+    completed = 0;
+    long long checksum = 0;
+
+    auto start = chrono::steady_clock::now();
+    for (long long cycle = 0; cycle < cycles; cycle++) {
+        for (LegacyServer* server : servers) {
+            if (server->isBusy() && server->advanceClockCycle()) {
+                LegacyRequest req = server->getCurrentRequest();
+                checksum += req.processTime + req.ipIn.size();
+                server->setIdle();
+                completed++;
+            }
+        }
+        for (LegacyServer* server : servers) {
+            if (!server->isBusy()) {
+                server->assignRequest(requests[next]);
+                next = (next + 1) % requests.size();
+            }
+        }
+    }
+    double elapsed = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+
+    for (LegacyServer* server : servers) {
+        delete server;
+    }
+    // keeps the request copies from being optimized away
+    if (checksum == 0 && completed > 0) {
+        cerr << "unexpected checksum" << endl;
+    }
+    return elapsed / (cycles * serverCount);
+}
+
+/**
+ * @brief Runs the ServerPool loop used by tick mode.
+ * @param serverCount Number of servers.
+ * @param cycles Number of cycles to run.
+ * @param requests Requests to start, cycled through in order.
+ * @param completed Set to the number of requests that finished.
+ * @return Nanoseconds per server per cycle.
+ */
+double runPool(int serverCount, long long cycles, const vector<Request>& requests, long long& completed) {
+    ServerPool pool;
+    for (int i = 0; i < serverCount; i++) {
+        pool.add(i + 1);
+    }
+    vector<uint64_t> completedMask;
+    vector<Request> batch(serverCount);
+    vector<int> slots(serverCount);
+    size_t next = 0;
+    completed = 0;
+
+    auto start = chrono::steady_clock::now();
+    for (long long cycle = 0; cycle < cycles; cycle++) {
+        if (pool.advanceClockCycle(completedMask) > 0) {
+            for (size_t word = 0; word < completedMask.size(); word++) {
+                uint64_t bits = completedMask[word];
+                while (bits != 0) {
+                    pool.release(word * 64 + __builtin_ctzll(bits), cycle);
+                    bits &= bits - 1;
+                    completed++;
+                }
+            }
+        }
+        int idle = pool.idleCount();
+        for (int i = 0; i < idle; i++) {
+            batch[i] = requests[next];
+            next = (next + 1) % requests.size();
+        }
+        pool.assignIdle(batch.data(), slots.data(), idle, cycle);
+    }
+    double elapsed = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    return elapsed / (cycles * serverCount);
+}
+
+int main() {
+    mt19937 gen(42);
+    uniform_int_distribution<int> time(5, 20);
+    vector<Request> requests;
+    vector<LegacyRequest> legacyRequests;
+    for (int i = 0; i < requestCount; i++) {
+        uint32_t ipIn = gen();
+        uint32_t ipOut = gen();
+        int processTime = time(gen);
+        char jobType = (gen() & 1) ? 'S' : 'P';
+        requests.push_back(Request(ipIn, ipOut, processTime, jobType));
+        legacyRequests.push_back(LegacyRequest{IpRange::toString(ipIn), IpRange::toString(ipOut), processTime, jobType});
+    }
+
+    cout << "SERVER POOL (ns per server per cycle, every server kept busy; " << serverCyclesPerRow << " server-cycles per row):" << endl;
+    cout << "  Servers          Old layout     ServerPool     Speedup   Completions (old / pool)" << endl;
+    for (int servers : {10, 1000, 100000}) {
+        long long cycles = serverCyclesPerRow / servers;
+        long long legacyCompleted = 0;
+        long long poolCompleted = 0;
+        double legacy = runLegacy(servers, cycles, legacyRequests, legacyCompleted);
+        double pool = runPool(servers, cycles, requests, poolCompleted);
+        cout << "  " << left << setw(9) << servers << right << fixed << setprecision(2)
+             << setw(18) << legacy << setw(15) << pool << setw(11) << legacy / pool << "x"
+             << "   " << legacyCompleted << " / " << poolCompleted << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,203 @@
+/**
+ * @file queuebench.cpp
+ * @brief Entry point for queuebench, which times the ring-buffer RequestQueue against the old std::queue wrapper.
+ *
+ * Usage:
+ * @code{.sh}
+ * make bench
+ * ./queuebench
+ * @endcode
+ *
+ * Two workloads, each reported in nanoseconds per request:
+ *  - steady: push a batch of 32 requests, then pop them, over and over,
+ *    as the simulation does once the queue has reached its working size;
+ *  - fill: push 1M requests into an empty queue, then pop them all, as
+ *    init() does with the prefill and as a backlog does when it builds up.
+ *
+ * The old queue is reproduced here as it was before the ring buffer: a
+ * std::queue (a deque) whose pop() copies the front request before
+ * removing it. Both queues hold the current 20-byte Request, so only the
+ * container differs, and the old methods are kept out of line, as
+ * RequestQueue's are in their own translation unit.
+ */
+
+#include "Request.h"
+#include "RequestQueue.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+/// Requests pushed and popped together in the steady workload
+static const int batchSize = 32;
+
+/// Requests moved through the queue per steady row
+static const long long steadyRequests = 100000000;
+
+/// Requests held at the peak of the fill workload
+static const int fillRequests = 1000000;
+
+/// Times each fill row is repeated
+static const int fillRounds = 20;
+
+/**
+ * @class LegacyRequestQueue
+ * @brief The request queue as it was before the ring buffer.
+ */
+class LegacyRequestQueue {
+    private:
+        std::queue<Request> queue;  ///< Underlying standard queue
+
+    public:
+        /** @brief Adds a request to the back. */
+        __attribute__((noinline)) void push(const Request& request) {
+            queue.push(request);
+        }
+
+        /** @brief Copies the front request out, then removes it. */
+        __attribute__((noinline)) Request pop() {
+            if (queue.empty()) {
+                throw runtime_error("Queue is empty");
+            }
+            Request frontRequest = queue.front();
+            queue.pop();
+            return frontRequest;
+        }
+};
+
+/**
+ * @brief Returns the nanoseconds elapsed since start, divided over count requests.
+ * @param start Time point the run started at.
+ * @param count Number of requests moved.
+ */
+double nsPerRequest(chrono::steady_clock::time_point start, long long count) {
+    return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / count;
+}
+
+/**
+ * @enum Mode
+ * @brief How requests are moved through the ring-buffer queue.
+ */
+enum class Mode {
+    PushPop,     ///< push() and pop(), one request at a time
+    PushTryPop,  ///< push() and tryPop(), one request at a time
+    Batch        ///< pushBatch() and popBatch()
+};
+
+/**
+ * @brief Moves requests through the old queue in rounds of push-then-pop.
+ * @param queue Queue under test, empty on entry and on return.
+ * @param requests Requests to push; each round pushes the first perRound of them.
+ * @param perRound Requests pushed and popped per round.
+ * @param rounds Number of rounds.
+ * @param checksum Accumulates the popped process times so the work is kept.
+ * @return Nanoseconds per request.
+ */
+double run(LegacyRequestQueue& queue, const vector<Request>& requests, int perRound, long long rounds,
+           long long& checksum) {
+    auto start = chrono::steady_clock::now();
+    for (long long r = 0; r < rounds; r++) {
+        for (int i = 0; i < perRound; i++) {
+            queue.push(requests[i]);
+        }
+        for (int i = 0; i < perRound; i++) {
+            checksum += queue.pop().getProcessTime();
+        }
+    }
+    return nsPerRequest(start, rounds * perRound);
+}
+
+/**
+ * @brief Moves requests through the ring-buffer queue in rounds of push-then-pop.
+ * @param queue Queue under test, empty on entry and on return.
+ * @param requests Requests to push; each round pushes the first perRound of them.
+ * @param perRound Requests pushed and popped per round.
+ * @param rounds Number of rounds.
+ * @param mode Which push and pop methods to use.
+ * @param checksum Accumulates the popped process times so the work is kept.
+ * @return Nanoseconds per request.
+ */
+double run(RequestQueue& queue, const vector<Request>& requests, int perRound, long long rounds, Mode mode,
+           long long& checksum) {
+    vector<Request> out(perRound);
+    auto start = chrono::steady_clock::now();
+    for (long long r = 0; r < rounds; r++) {
+        if (mode == Mode::Batch) {
+            queue.pushBatch(requests.data(), perRound);
+            int popped = queue.popBatch(out.data(), perRound);
+            for (int i = 0; i < popped; i++) {
+                checksum += out[i].getProcessTime();
+            }
+            continue;
+        }
+        for (int i = 0; i < perRound; i++) {
+            queue.push(requests[i]);
+        }
+        Request request;
+        for (int i = 0; i < perRound; i++) {
+            if (mode == Mode::PushPop) {
+                request = queue.pop();
+            } else {
+                queue.tryPop(request);
+            }
+            checksum += request.getProcessTime();
+        }
+    }
+    return nsPerRequest(start, rounds * perRound);
+}
+
+int main() {
+    vector<Request> requests;
+    for (int i = 0; i < fillRequests; i++) {
+        requests.push_back(Request(i, ~i, 5 + i % 16, (i & 1) ? 'S' : 'P'));
+    }
+
+    struct Row {
+        const char* label;   ///< Row label
+        bool legacy;         ///< True for the old queue
+        Mode mode;           ///< How the ring-buffer queue is driven; ignored for the old queue
+    };
+    const Row rows[] = {
+        {"old std::queue, push+pop", true, Mode::PushPop},
+        {"ring, push+pop", false, Mode::PushPop},
+        {"ring, push+tryPop", false, Mode::PushTryPop},
+        {"ring, pushBatch+popBatch", false, Mode::Batch},
+    };
+
+    long long checksum = 0;
+    cout << "REQUEST QUEUE (ns per request; steady: batches of " << batchSize << ", fill: "
+         << fillRequests << " requests into an empty queue, best of " << fillRounds << "):" << endl;
+    cout << "  Queue                          Steady      Fill" << endl;
+    cout << fixed << setprecision(2);
+    for (const Row& row : rows) {
+        double steady = 0;
+        double fill = 0;
+        if (row.legacy) {
+            LegacyRequestQueue queue;
+            steady = run(queue, requests, batchSize, steadyRequests / batchSize, checksum);
+        } else {
+            RequestQueue queue;
+            steady = run(queue, requests, batchSize, steadyRequests / batchSize, row.mode, checksum);
+        }
+        // a fresh queue every round, so the fill pays for growing the container each time
+        for (int round = 0; round < fillRounds; round++) {
+            double ns;
+            if (row.legacy) {
+                LegacyRequestQueue queue;
+                ns = run(queue, requests, fillRequests, 1, checksum);
+            } else {
+                RequestQueue queue;
+                ns = run(queue, requests, fillRequests, 1, row.mode, checksum);
+            }
+            fill = round == 0 ? ns : min(fill, ns);
+        }
+        cout << "  " << left << setw(27) << row.label << right << setw(10) << steady << setw(10) << fill << endl;
+    }
+    // printing the checksum keeps the popped requests from being optimized away
+    cout << "  (checksum " << checksum << ")" << endl;
+    return 0;
+}
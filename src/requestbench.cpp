@@ -0,0 +1,191 @@
+/**
+ * @file requestbench.cpp
+ * @brief Entry point for requestbench, which times LoadBalancer::addRequest() against the old string-based request path.
+ *
+ * Usage:
+ * @code{.sh}
+ * make bench
+ * ./requestbench [requests]
+ * @endcode
+ *
+ * Both sides admit the same pre-generated requests, drawn from a fixed
+ * seed, against the two blocked ranges of the shipped config.txt. The
+ * current side is LoadBalancer::addRequest() with a stats-only LogFile and
+ * otherwise default settings, so it also pays for the shed policy and,
+ * in the first of its two rows, top-talker tracking.
+ *
+ * The old side is reproduced here as it was before addresses became
+ * uint32_t: requests hold two string addresses, the getters return them by
+ * value, every blocked-range check parses the address and both bounds
+ * through istringstream, and accepted requests go into a std::queue.
+ */
+
+#include "Config.h"
+#include "IpRange.h"
+#include "LoadBalancer.h"
+#include "LogFile.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/// Blocked ranges of the shipped config.txt
+static const char* blockedRanges = "10.0.0.0-10.0.0.255,192.168.1.0-192.168.1.50";
+
+/**
+ * @class LegacyRequest
+ * @brief The request as it was before addresses became uint32_t.
+ */
+class LegacyRequest {
+    private:
+        string ipIn;       ///< Source IP address in dotted form
+        string ipOut;      ///< Destination IP address in dotted form
+        int processTime;   ///< Clock cycles the request takes
+        char jobType;      ///< 'P' or 'S'
+
+    public:
+        /** @brief Creates a request. */
+        LegacyRequest(string ipIn, string ipOut, int processTime, char jobType)
+            : ipIn(ipIn), ipOut(ipOut), processTime(processTime), jobType(jobType) {
+        }
+
+        /** @brief Returns the source address by value, as the old getter did. */
+        string getIpIn() const {
+            return ipIn;
+        }
+};
+
+/**
+ * @class LegacyIpRange
+ * @brief The blocked range as it was before it parsed its bounds once.
+ */
+class LegacyIpRange {
+    private:
+        string startIp;   ///< First address in the range
+        string endIp;     ///< Last address in the range
+
+        /** @brief Parses a dotted address, as the old ipToNum() did. */
+        long ipToNum(const string& ip) const {
+            long res = 0;
+            istringstream iss(ip);
+            string token;
+            while (getline(iss, token, '.')) {
+                res = res * 256 + stoi(token);
+            }
+            return res;
+        }
+
+    public:
+        /** @brief Creates a range from its two bounds. */
+        LegacyIpRange(const string& startIp, const string& endIp) : startIp(startIp), endIp(endIp) {
+        }
+
+        /** @brief Returns true if ip lies within the range. */
+        bool contains(const string& ip) const {
+            long ipNum = ipToNum(ip);
+            return ipNum >= ipToNum(startIp) && ipNum <= ipToNum(endIp);
+        }
+};
+
+/**
+ * @brief Admits requests the way the old LoadBalancer::addRequest() did.
+ * @param requests Requests to admit.
+ * @param accepted Set to the number of requests queued.
+ * @return Requests per second.
+ */
+double runLegacy(const vector<LegacyRequest>& requests, long long& accepted) {
+    vector<LegacyIpRange> ranges = {LegacyIpRange("10.0.0.0", "10.0.0.255"),
+                                    LegacyIpRange("192.168.1.0", "192.168.1.50")};
+    queue<LegacyRequest> requestQueue;
+    accepted = 0;
+
+    auto start = chrono::steady_clock::now();
+    for (const LegacyRequest& request : requests) {
+        bool blocked = false;
+        for (const LegacyIpRange& range : ranges) {
+            if (range.contains(request.getIpIn())) {
+                blocked = true;
+                break;
+            }
+        }
+        if (!blocked) {
+            requestQueue.push(request);
+            accepted++;
+        }
+    }
+    return requests.size() / chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Admits requests through LoadBalancer::addRequest().
+ * @param requests Requests to admit.
+ * @param topTalkers Value of the topTalkers setting; 0 turns the tracking off.
+ * @param accepted Set to the number of requests queued.
+ * @return Requests per second.
+ */
+double runCurrent(const vector<Request>& requests, int topTalkers, long long& accepted) {
+    Config config;
+    config.applySetting("seed", "42");
+    config.applySetting("blockedIpRanges", blockedRanges);
+    config.applySetting("topTalkers", to_string(topTalkers));
+    LogFile stats;
+    LoadBalancer loadBalancer(config, &stats);
+    accepted = 0;
+
+    auto start = chrono::steady_clock::now();
+    for (const Request& request : requests) {
+        accepted += loadBalancer.addRequest(request);
+    }
+    return requests.size() / chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? atoi(argv[1]) : 1000000;
+    if (count <= 0) {
+        cerr << "Usage: " << argv[0] << " [requests]" << endl;
+        return 2;
+    }
+
+    // one request in 64 comes from a blocked range, so both outcomes are exercised
+    mt19937 gen(42);
+    uniform_int_distribution<int> time(5, 20);
+    vector<Request> requests;
+    vector<LegacyRequest> legacyRequests;
+    for (int i = 0; i < count; i++) {
+        uint32_t ipIn = gen();
+        if (i % 64 == 0) {
+            ipIn = (10u << 24) | (ipIn & 0xFF);
+        }
+        uint32_t ipOut = gen();
+        int processTime = time(gen);
+        char jobType = (gen() & 1) ? 'S' : 'P';
+        requests.push_back(Request(ipIn, ipOut, processTime, jobType));
+        legacyRequests.push_back(LegacyRequest(IpRange::toString(ipIn), IpRange::toString(ipOut), processTime, jobType));
+    }
+
+    long long legacyAccepted = 0;
+    long long currentAccepted = 0;
+    long long untrackedAccepted = 0;
+    double legacy = runLegacy(legacyRequests, legacyAccepted);
+    double current = runCurrent(requests, 10, currentAccepted);
+    double untracked = runCurrent(requests, 0, untrackedAccepted);
+
+    cout << "ADD REQUEST (" << count << " requests, blocked ranges " << blockedRanges << "):" << endl;
+    cout << "  Path                          Mreq/s    Accepted   Speedup" << endl;
+    cout << fixed << setprecision(2);
+    cout << "  " << left << setw(26) << "old strings" << right << setw(10) << legacy / 1e6
+         << setw(12) << legacyAccepted << endl;
+    cout << "  " << left << setw(26) << "addRequest" << right << setw(10) << current / 1e6
+         << setw(12) << currentAccepted << setw(9) << setprecision(0) << current / legacy << "x" << endl;
+    cout << setprecision(2);
+    cout << "  " << left << setw(26) << "addRequest, topTalkers=0" << right << setw(10) << untracked / 1e6
+         << setw(12) << untrackedAccepted << setw(9) << setprecision(0) << untracked / legacy << "x" << endl;
+    return legacyAccepted == currentAccepted && legacyAccepted == untrackedAccepted ? 0 : 1;
+}